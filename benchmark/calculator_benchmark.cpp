@@ -0,0 +1,380 @@
+// Calculator microbenchmark suite with JSON output and baseline comparison.
+//
+//   calculator_benchmark [--json FILE] [--compare BASELINE] [--threshold PCT]
+//                        [--filter TEXT] [--repetitions N]
+//
+// Every case runs `repetitions` timed passes over a fixed, seeded input set
+// and reports the median ns/op together with the fastest and slowest pass.
+// --json writes the results; --compare reads an earlier --json file and marks
+// every case whose median is more than --threshold percent (default 10)
+// slower than the baseline. The exit status is 1 if any case regressed.
+//
+// Only database-free sources are linked, so this builds without MySQL; see
+// CMakeLists.txt in this directory.
+
+#include "Calculator.h"
+#include "Calculation_Record.h"
+#include "Cost.h"
+#include "Environment.h"
+#include "Vehicle.h"
+#include "Vehicle_Catalog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct CaseResult {
+        std::string name;
+        size_t ops = 0;
+        double nsPerOp = 0.0; // median pass
+        double minNs = 0.0;
+        double maxNs = 0.0;
+    };
+
+    struct Options {
+        std::string jsonPath;
+        std::string baselinePath;
+        std::string filter;
+        double thresholdPct = 10.0;
+        int repetitions = 15;
+    };
+
+    volatile double sink;
+
+    // One warm-up pass, then `repetitions` timed passes of `ops` operations each
+    CaseResult measure(const std::string& name, size_t ops, int repetitions, const std::function<double()>& pass) {
+        sink = pass();
+
+        std::vector<double> samples;
+        samples.reserve(repetitions);
+        for (int r = 0; r < repetitions; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            sink = pass();
+            auto stop = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / ops);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        CaseResult result;
+        result.name = name;
+        result.ops = ops;
+        result.nsPerOp = samples[samples.size() / 2];
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        return result;
+    }
+
+    // ---- Input sets -------------------------------------------------------
+
+    struct MissionInputs {
+        std::vector<Vehicle> vehicles;
+        std::vector<Environment> environments;
+        std::vector<double> distanceKm;
+        std::vector<double> speedKmh;
+    };
+
+    // Fleet mix: 60% cars, 25% vans and light trucks, 15% heavy trucks, on
+    // mostly gentle gradients with a few steep ones
+    MissionInputs makeMissions(size_t count, std::mt19937_64& rng) {
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        std::normal_distribution<double> gradient(0.0, 0.03);
+        const double roughness[] = { 1.0, 1.0, 1.0, 1.5, 2.5 };
+
+        MissionInputs in;
+        in.vehicles.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            double kind = u(rng);
+            Vehicle v("BENCH", 0, 0, 0, 0);
+            if (kind < 0.60) {
+                v.massKg = 1100 + u(rng) * 900;
+                v.dragCoef = 0.26 + u(rng) * 0.12;
+                v.frontalArea = 2.0 + u(rng) * 0.6;
+                v.engineRatedPower = 70 + u(rng) * 130;
+                v.tirePressureBar = 2.2 + u(rng) * 0.4;
+            }
+            else if (kind < 0.85) {
+                v.massKg = 2500 + u(rng) * 4500;
+                v.dragCoef = 0.35 + u(rng) * 0.15;
+                v.frontalArea = 3.5 + u(rng) * 2.5;
+                v.engineRatedPower = 100 + u(rng) * 100;
+                v.tirePressureBar = 3.5 + u(rng) * 1.5;
+            }
+            else {
+                v.massKg = 12000 + u(rng) * 28000;
+                v.dragCoef = 0.55 + u(rng) * 0.25;
+                v.frontalArea = 8.0 + u(rng) * 2.0;
+                v.engineRatedPower = 240 + u(rng) * 220;
+                v.tirePressureBar = 7.0 + u(rng) * 2.0;
+            }
+            v.hasAC = u(rng) < 0.7;
+            v.refreshCoefficients();
+            in.vehicles.push_back(v);
+
+            Environment e;
+            e.setRawEnvironment(std::clamp(gradient(rng), -0.15, 0.15),
+                roughness[static_cast<size_t>(u(rng) * 5)], -10.0 + u(rng) * 50.0);
+            in.environments.push_back(e);
+
+            in.distanceKm.push_back(5.0 + u(rng) * 495.0);
+            in.speedKmh.push_back(20.0 + u(rng) * 90.0);
+        }
+        return in;
+    }
+
+    std::string formatTimestamp(std::mt19937_64& rng) {
+        std::uniform_int_distribution<int> year(2023, 2026), month(1, 12), day(1, 28),
+            hour(0, 23), minute(0, 59), second(0, 59);
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d",
+            year(rng), month(rng), day(rng), hour(rng), minute(rng), second(rng));
+        return buffer;
+    }
+
+    // ---- Cases ------------------------------------------------------------
+
+    std::vector<CaseResult> runSuite(const Options& opt) {
+        const size_t MISSIONS = 1 << 16;
+        const size_t ROWS = 1 << 12;
+
+        std::mt19937_64 rng(20240601);
+        MissionInputs missions = makeMissions(MISSIONS, rng);
+
+        std::vector<CalculationRecord> records(ROWS);
+        for (CalculationRecord& record : records) record.calculated_at = formatTimestamp(rng);
+
+        std::vector<double> kmPerLiter(MISSIONS);
+        std::uniform_real_distribution<double> efficiency(2.0, 25.0);
+        for (double& k : kmPerLiter) k = efficiency(rng);
+
+        // A 400-vehicle fleet filled without storage, looked up by random id
+        const size_t FLEET = 400;
+        std::vector<Vehicle> fleet(missions.vehicles.begin(), missions.vehicles.begin() + FLEET);
+        for (size_t i = 0; i < FLEET; ++i) fleet[i].vehicle_id = "VEH-" + std::to_string(i);
+        VehicleCatalog catalog(nullptr);
+        catalog.reset(fleet);
+
+        std::vector<std::string> lookupIds(ROWS);
+        std::uniform_int_distribution<size_t> pick(0, FLEET - 1);
+        for (std::string& id : lookupIds) id = "VEH-" + std::to_string(pick(rng));
+
+        Calculator calculator;
+        Cost cost;
+
+        std::vector<CaseResult> results;
+        auto run = [&](const std::string& name, size_t ops, const std::function<double()>& pass) {
+            if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+            results.push_back(measure(name, ops, opt.repetitions, pass));
+        };
+
+        run("Calculator::calculate", MISSIONS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < MISSIONS; ++i) {
+                acc += calculator.calculate(missions.vehicles[i], missions.environments[i],
+                    missions.distanceKm[i], missions.speedKmh[i]);
+            }
+            return acc;
+        });
+
+        // Repeated missions for one vehicle, with its coefficients derived
+        // once and, for comparison ("uncached"), rederived on every call
+        const Vehicle& truck = missions.vehicles.back();
+        Vehicle staleTruck = truck;
+        staleTruck.coefficients = VehicleCoefficients();
+
+        run("Calculator::calculate, same vehicle", MISSIONS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < MISSIONS; ++i) {
+                acc += calculator.calculate(truck, missions.environments[i], missions.distanceKm[i], missions.speedKmh[i]);
+            }
+            return acc;
+        });
+
+        run("Calculator::calculate, uncached", MISSIONS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < MISSIONS; ++i) {
+                acc += calculator.calculate(staleTruck, missions.environments[i], missions.distanceKm[i], missions.speedKmh[i]);
+            }
+            return acc;
+        });
+
+        run("Environment::getAirDensity", MISSIONS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < MISSIONS; ++i) acc += missions.environments[i].getAirDensity();
+            return acc;
+        });
+
+        run("CalculationRecord::getFormattedDate", ROWS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < ROWS; ++i) acc += static_cast<double>(records[i].getFormattedDate().size());
+            return acc;
+        });
+
+        run("VehicleCatalog::find", ROWS, [&] {
+            Vehicle found(nullptr);
+            double acc = 0.0;
+            for (size_t i = 0; i < ROWS; ++i) {
+                if (catalog.find(lookupIds[i], found)) acc += found.massKg;
+            }
+            return acc;
+        });
+
+        run("Cost::calculate", MISSIONS, [&] {
+            double acc = 0.0;
+            for (size_t i = 0; i < MISSIONS; ++i) acc += cost.calculate(kmPerLiter[i]);
+            return acc;
+        });
+
+        return results;
+    }
+
+    // ---- JSON -------------------------------------------------------------
+
+    bool writeJSON(const std::string& path, const Options& opt, const std::vector<CaseResult>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << path << " for writing\n";
+            return false;
+        }
+
+        file << "{\n";
+        file << "  \"suite\": \"calculator_benchmark\",\n";
+#if defined(__AVX2__)
+        file << "  \"simd\": \"avx2\",\n";
+#else
+        file << "  \"simd\": \"none\",\n";
+#endif
+        file << "  \"repetitions\": " << opt.repetitions << ",\n";
+        file << "  \"results\": [\n";
+        file << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const CaseResult& r = results[i];
+            file << "    { \"name\": \"" << r.name << "\", \"ops\": " << r.ops
+                << ", \"ns_per_op\": " << r.nsPerOp
+                << ", \"min_ns\": " << r.minNs
+                << ", \"max_ns\": " << r.maxNs << " }"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return true;
+    }
+
+    // Reads name -> ns_per_op from a file written by writeJSON
+    bool readBaseline(const std::string& path, std::map<std::string, double>& out) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open baseline " << path << "\n";
+            return false;
+        }
+        std::stringstream ss;
+        ss << file.rdbuf();
+        std::string text = ss.str();
+
+        size_t pos = 0;
+        while ((pos = text.find("\"name\"", pos)) != std::string::npos) {
+            size_t open = text.find('"', text.find(':', pos) + 1);
+            size_t close = text.find('"', open + 1);
+            size_t key = text.find("\"ns_per_op\"", close);
+            if (open == std::string::npos || close == std::string::npos || key == std::string::npos) break;
+
+            std::string name = text.substr(open + 1, close - open - 1);
+            out[name] = std::strtod(text.c_str() + text.find(':', key) + 1, nullptr);
+            pos = key;
+        }
+
+        if (out.empty()) {
+            std::cerr << "Baseline " << path << " contains no results\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Prints the comparison table; returns the number of regressions
+    int compare(const std::vector<CaseResult>& results, const std::map<std::string, double>& baseline, double thresholdPct) {
+        std::cout << "\nComparison against baseline (threshold " << std::fixed << std::setprecision(1)
+            << thresholdPct << "%)\n";
+        std::cout << std::left << std::setw(38) << "benchmark"
+            << std::right << std::setw(12) << "baseline" << std::setw(12) << "current"
+            << std::setw(10) << "change" << "  status\n";
+
+        int regressions = 0;
+        for (const CaseResult& r : results) {
+            auto it = baseline.find(r.name);
+            std::cout << std::left << std::setw(38) << r.name << std::right << std::setprecision(2);
+            if (it == baseline.end() || it->second <= 0.0) {
+                std::cout << std::setw(12) << "-" << std::setw(9) << r.nsPerOp << " ns"
+                    << std::setw(10) << "-" << "  new\n";
+                continue;
+            }
+
+            double change = (r.nsPerOp / it->second - 1.0) * 100.0;
+            const char* status = "ok";
+            if (change > thresholdPct) {
+                status = "REGRESSION";
+                ++regressions;
+            }
+            else if (change < -thresholdPct) {
+                status = "improved";
+            }
+
+            std::cout << std::setw(9) << it->second << " ns" << std::setw(9) << r.nsPerOp << " ns"
+                << std::setw(9) << std::showpos << std::setprecision(1) << change << "%" << std::noshowpos
+                << "  " << status << "\n";
+        }
+        return regressions;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--json" && hasValue) opt.jsonPath = argv[++i];
+            else if (arg == "--compare" && hasValue) opt.baselinePath = argv[++i];
+            else if (arg == "--threshold" && hasValue) opt.thresholdPct = std::atof(argv[++i]);
+            else if (arg == "--filter" && hasValue) opt.filter = argv[++i];
+            else if (arg == "--repetitions" && hasValue) opt.repetitions = std::max(1, std::atoi(argv[++i]));
+            else {
+                std::cerr << "Usage: " << argv[0] << " [--json FILE] [--compare BASELINE] [--threshold PCT]"
+                    " [--filter TEXT] [--repetitions N]\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    std::map<std::string, double> baseline;
+    if (!opt.baselinePath.empty() && !readBaseline(opt.baselinePath, baseline)) return 2;
+
+    std::vector<CaseResult> results = runSuite(opt);
+
+    std::cout << std::left << std::setw(38) << "benchmark"
+        << std::right << std::setw(12) << "median" << std::setw(12) << "min" << std::setw(12) << "max" << "\n";
+    for (const CaseResult& r : results) {
+        std::cout << std::left << std::setw(38) << r.name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(9) << r.nsPerOp << " ns"
+            << std::setw(9) << r.minNs << " ns"
+            << std::setw(9) << r.maxNs << " ns\n";
+    }
+
+    if (!opt.jsonPath.empty() && !writeJSON(opt.jsonPath, opt, results)) return 2;
+
+    if (!baseline.empty() && compare(results, baseline, opt.thresholdPct) > 0) return 1;
+
+    return 0;
+}
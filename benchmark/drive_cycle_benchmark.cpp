@@ -0,0 +1,58 @@
+// DriveCycle: batch-path throughput over an in-memory stop-and-go trace, and
+// the fuel difference against the average-speed model.
+//
+// Built by CMakeLists.txt in this directory, without MySQL:
+//   cmake -S benchmark -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench --target drive_cycle_benchmark
+
+#include "Calculator.h"
+#include "Drive_Cycle.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+int main() {
+    const size_t N = 1 << 25; // ~33.5M samples, about 388 days at 1 Hz
+    const int repeats = 5;
+
+    // Urban cycle: 20 s stopped, 30 s accelerating to 60 km/h,
+    // 40 s cruising, 30 s braking
+    std::vector<double> trace(N);
+    for (size_t i = 0; i < N; ++i) {
+        double t = static_cast<double>(i % 120);
+        if (t < 20) trace[i] = 0.0;
+        else if (t < 50) trace[i] = (t - 20) * 2.0;
+        else if (t < 90) trace[i] = 60.0;
+        else trace[i] = (std::max)(0.0, 60.0 - (t - 90) * 2.0);
+    }
+
+    Vehicle vehicle("BENCH", 12000, 0.6, 7.5, 250);
+    vehicle.tirePressureBar = 6.0;
+    Environment environment;
+    environment.setRawEnvironment(0.0, 1.0, 15.0);
+
+    double best = 1e300;
+    DriveCycleResult result;
+    for (int r = 0; r < repeats; ++r) {
+        DriveCycle cycle(vehicle, environment);
+        auto start = std::chrono::steady_clock::now();
+        cycle.addSamples(trace.data(), N);
+        auto stop = std::chrono::steady_clock::now();
+        best = (std::min)(best, std::chrono::duration<double>(stop - start).count());
+        result = cycle.result();
+    }
+
+    Calculator calculator;
+    double steady = calculator.calculate(vehicle, environment, result.distanceKm, result.averageSpeedKmh());
+
+    std::cout << "Samples:             " << N << "\n";
+    std::cout << "Throughput:          " << std::fixed << std::setprecision(1)
+        << N / best / 1e6 << " M samples/s (single thread)\n";
+    std::cout << "Drive-cycle fuel:    " << std::setprecision(2) << result.liters << " L\n";
+    std::cout << "Average-speed model: " << steady << " L ("
+        << std::setprecision(1) << (result.liters / steady - 1.0) * 100.0 << "% difference)\n";
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Engine-efficiency curve: per-call cubic vs compile-time table.
+//
+// Built by CMakeLists.txt in this directory, without MySQL:
+//   cmake -S benchmark -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench --target efficiency_benchmark
+
+#include "Calculator.h"
+#include "Efficiency_Table.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+    // The curve exactly as Calculator evaluated it before the table
+    double polynomialEfficiency(double loadFactor) {
+        double x = std::clamp(loadFactor, 0.2, 1.0);
+        double efficiency = 0.5968 * x - 0.1666 * pow(x, 2) + 2.4968 * pow(x, 3) - 2.1128 + 0.4;
+        return std::clamp(efficiency, 0.30, 0.45);
+    }
+
+    // Single-mission physics with the polynomial, for the end-to-end comparison
+    double polynomialMission(double mass, double cd, double area, double tire, double power,
+        double grad, double rough, double temp, double dist, double speed) {
+        double v = speed / 3.6;
+        double durationSec = (dist * 1000.0) / v;
+        double g = 9.81;
+        double rho = 101325.0 / (287.058 * (temp + 273.15));
+        double C_rr = rough * std::pow(tire, -0.477);
+        double F_roll = C_rr * mass * g * std::cos(std::atan(grad));
+        double F_aero = 0.5 * rho * cd * area * std::pow(v, 2);
+        double F_grade = mass * g * std::sin(std::atan(grad));
+        double P_wheels = (std::max)(0.0, (F_roll + F_aero + F_grade) * v);
+        double P_required = (P_wheels / 0.85) + 300.0;
+        double efficiency = polynomialEfficiency(P_required / (power * 1000.0));
+        return (P_required * durationSec) / (43000000.0 * efficiency) / 0.832;
+    }
+
+    template <typename F>
+    double nsPerOp(size_t ops, int repeats, F&& body) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto stop = std::chrono::steady_clock::now();
+            best = (std::min)(best, std::chrono::duration<double, std::nano>(stop - start).count() / ops);
+        }
+        return best;
+    }
+
+    void report(const char* name, double before, double after) {
+        std::cout << std::left << std::setw(34) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << before << " ns"
+            << std::setw(10) << after << " ns"
+            << std::setw(9) << (before / after) << "x\n";
+    }
+
+    volatile double sink;
+}
+
+int main() {
+    const size_t N = 1 << 20;
+    const int repeats = 7;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> load(0.0, 1.2);
+    std::vector<double> loads(N), out(N);
+    for (double& x : loads) x = load(rng);
+
+    // Realistic mission mix: light vehicles to heavy trucks, mixed terrain
+    std::vector<double> mass(N), cd(N), area(N), tire(N), power(N),
+        grad(N), rough(N), temp(N), dist(N), speed(N);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (size_t i = 0; i < N; ++i) {
+        mass[i] = 1500 + u(rng) * 38000;
+        cd[i] = 0.3 + u(rng) * 0.5;
+        area[i] = 2.2 + u(rng) * 7.0;
+        tire[i] = 2.0 + u(rng) * 6.5;
+        power[i] = 90 + u(rng) * 350;
+        grad[i] = -0.08 + u(rng) * 0.16;
+        rough[i] = 1.0 + u(rng) * 1.5;
+        temp[i] = -5 + u(rng) * 45;
+        dist[i] = 5 + u(rng) * 400;
+        speed[i] = 20 + u(rng) * 90;
+    }
+
+    std::cout << "Efficiency table: " << EfficiencyTable::SIZE << " entries, max |error| "
+        << std::scientific << std::setprecision(2) << EfficiencyTable::maxMidpointError()
+        << " (bound " << EfficiencyTable::MAX_ABS_ERROR << ")\n\n";
+
+    std::cout << std::left << std::setw(34) << "benchmark"
+        << std::right << std::setw(13) << "polynomial" << std::setw(13) << "table" << std::setw(10) << "speedup\n";
+
+    // Single: one dependent call at a time
+    double single_poly = nsPerOp(N, repeats, [&] {
+        double acc = 0;
+        for (size_t i = 0; i < N; ++i) acc += polynomialEfficiency(loads[i] + acc * 1e-300);
+        sink = acc;
+    });
+    double single_table = nsPerOp(N, repeats, [&] {
+        double acc = 0;
+        for (size_t i = 0; i < N; ++i) acc += EfficiencyTable::lookup(loads[i] + acc * 1e-300);
+        sink = acc;
+    });
+    report("efficiency, single call", single_poly, single_table);
+
+    // Batch: independent evaluations over an array
+    double batch_poly = nsPerOp(N, repeats, [&] {
+        for (size_t i = 0; i < N; ++i) out[i] = polynomialEfficiency(loads[i]);
+        sink = out[N / 2];
+    });
+    double batch_table = nsPerOp(N, repeats, [&] {
+        for (size_t i = 0; i < N; ++i) out[i] = EfficiencyTable::lookup(loads[i]);
+        sink = out[N / 2];
+    });
+    report("efficiency, batch of 1M", batch_poly, batch_table);
+
+    // End-to-end single mission: previous formula vs Calculator::calculate.
+    // Vehicles are built up front, as loadVehicle would hand them out with
+    // their coefficients derived, over the first M missions
+    const size_t M = 1 << 16;
+    Calculator calculator;
+    std::vector<Vehicle> vehicles;
+    vehicles.reserve(M);
+    for (size_t i = 0; i < M; ++i) {
+        vehicles.emplace_back("BENCH", mass[i], cd[i], area[i], power[i]);
+        vehicles.back().setTirePressure(tire[i]);
+    }
+    Environment environment;
+    double mission_poly = nsPerOp(M, repeats, [&] {
+        double acc = 0;
+        for (size_t i = 0; i < M; ++i) {
+            acc += polynomialMission(mass[i], cd[i], area[i], tire[i], power[i],
+                grad[i], rough[i], temp[i], dist[i], speed[i]);
+        }
+        sink = acc;
+    });
+    double mission_table = nsPerOp(M, repeats, [&] {
+        double acc = 0;
+        for (size_t i = 0; i < M; ++i) {
+            environment.setRawEnvironment(grad[i], rough[i], temp[i]);
+            acc += calculator.calculate(vehicles[i], environment, dist[i], speed[i]);
+        }
+        sink = acc;
+    });
+    report("calculate(), single mission", mission_poly, mission_table);
+
+    // End-to-end batch: scalar polynomial loop vs calculateBatch
+    MissionBatch batch;
+    batch.count = N;
+    batch.massKg = mass.data(); batch.dragCoef = cd.data(); batch.frontalArea = area.data();
+    batch.tirePressureBar = tire.data(); batch.engineRatedPower = power.data();
+    batch.roadGradient = grad.data(); batch.surfaceRoughness = rough.data(); batch.ambientTempC = temp.data();
+    batch.distanceKm = dist.data(); batch.avgSpeedKmh = speed.data();
+
+    double missions_poly = nsPerOp(N, repeats, [&] {
+        for (size_t i = 0; i < N; ++i) {
+            out[i] = polynomialMission(mass[i], cd[i], area[i], tire[i], power[i],
+                grad[i], rough[i], temp[i], dist[i], speed[i]);
+        }
+        sink = out[N / 2];
+    });
+    double missions_table = nsPerOp(N, repeats, [&] {
+        calculator.calculateBatch(batch, out.data());
+        sink = out[N / 2];
+    });
+    report("calculateBatch(), 1M missions", missions_poly, missions_table);
+
+    return 0;
+}
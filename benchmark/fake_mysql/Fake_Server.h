@@ -0,0 +1,28 @@
+#ifndef FAKE_SERVER_H
+#define FAKE_SERVER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the in-memory stand-in for the MySQL client library (mysql.h) answers.
+//
+// Every statement, prepared or text, gets the same canned reply until it is
+// changed: a SELECT returns the rows set here, anything else reports the set
+// number of affected rows. Values are given as text, the way the text
+// protocol sends them, and converted to the type each result column binds.
+//
+// requests() counts what would cross the network to a real server - connects,
+// pings, prepares, executes and text queries - so callers can check it
+// against what DatabaseManager records in its QueryLog. Single-threaded.
+namespace FakeServer {
+
+    void setRows(const std::vector<std::vector<std::string>>& rows);
+    void setAffectedRows(uint64_t rows);
+
+    uint64_t requests();
+    const std::string& lastStatement();
+
+}
+
+#endif
@@ -0,0 +1,276 @@
+#include "mysql.h"
+#include "Fake_Server.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct st_mysql {
+    unsigned long threadId = 0;
+    bool hasResult = false;     // last text query was a SELECT
+    my_ulonglong affected = 0;
+};
+
+struct st_mysql_res {
+    std::vector<std::vector<std::string>> rows;
+    std::vector<char*> row;     // pointers into the current row
+    size_t next = 0;
+};
+
+struct st_mysql_stmt {
+    std::string sql;
+    MYSQL_BIND* result = nullptr;
+    std::vector<std::vector<std::string>> rows;
+    size_t next = 0;            // row after the one last fetched
+    bool select = false;
+    my_ulonglong affected = 0;
+};
+
+namespace {
+
+    struct Server {
+        std::vector<std::vector<std::string>> rows;
+        uint64_t affectedRows = 1;
+        uint64_t requests = 0;
+        unsigned long sessions = 0;
+        std::string lastStatement;
+    };
+    Server server;
+
+    bool isSelect(const std::string& sql) {
+        size_t start = sql.find_first_not_of(" \t\r\n(");
+        if (start == std::string::npos || sql.size() - start < 6) return false;
+        std::string word = sql.substr(start, 6);
+        for (char& c : word) c = (char)std::toupper((unsigned char)c);
+        return word == "SELECT";
+    }
+
+    // One text value into a bound result column; false if it was cut short
+    bool store(const std::string& value, MYSQL_BIND& bind) {
+        if (bind.is_null) *bind.is_null = false;
+        if (bind.error) *bind.error = false;
+
+        switch (bind.buffer_type) {
+        case MYSQL_TYPE_LONG:
+            *static_cast<int*>(bind.buffer) = std::atoi(value.c_str());
+            break;
+        case MYSQL_TYPE_DOUBLE:
+            *static_cast<double*>(bind.buffer) = std::strtod(value.c_str(), nullptr);
+            break;
+        case MYSQL_TYPE_DATETIME: {
+            MYSQL_TIME* t = static_cast<MYSQL_TIME*>(bind.buffer);
+            std::memset(t, 0, sizeof(*t));
+            std::sscanf(value.c_str(), "%u-%u-%u %u:%u:%u",
+                &t->year, &t->month, &t->day, &t->hour, &t->minute, &t->second);
+            break;
+        }
+        case MYSQL_TYPE_STRING: {
+            unsigned long length = (unsigned long)value.size();
+            if (bind.length) *bind.length = length;
+            std::memcpy(bind.buffer, value.data(), (std::min)(length, bind.buffer_length));
+            if (length > bind.buffer_length) {
+                if (bind.error) *bind.error = true;
+                return false;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        return true;
+    }
+
+}
+
+namespace FakeServer {
+
+    void setRows(const std::vector<std::vector<std::string>>& rows) {
+        server.rows = rows;
+    }
+
+    void setAffectedRows(uint64_t rows) {
+        server.affectedRows = rows;
+    }
+
+    uint64_t requests() {
+        return server.requests;
+    }
+
+    const std::string& lastStatement() {
+        return server.lastStatement;
+    }
+
+}
+
+// ---- Library and connections --------------------------------------------
+
+int mysql_library_init(int, char**, char**) { return 0; }
+my_bool mysql_thread_init(void) { return false; }
+void mysql_thread_end(void) {}
+
+MYSQL* mysql_init(MYSQL*) {
+    return new st_mysql();
+}
+
+MYSQL* mysql_real_connect(MYSQL* mysql, const char*, const char*, const char*,
+    const char*, unsigned int, const char*, unsigned long) {
+    ++server.requests;
+    mysql->threadId = ++server.sessions;
+    return mysql;
+}
+
+void mysql_close(MYSQL* mysql) {
+    delete mysql;
+}
+
+int mysql_ping(MYSQL*) {
+    ++server.requests;
+    return 0;
+}
+
+unsigned long mysql_thread_id(MYSQL* mysql) {
+    return mysql->threadId;
+}
+
+const char* mysql_error(MYSQL*) {
+    return "";
+}
+
+unsigned long mysql_real_escape_string(MYSQL*, char* to, const char* from, unsigned long length) {
+    unsigned long written = 0;
+    for (unsigned long i = 0; i < length; ++i) {
+        if (from[i] == '\'' || from[i] == '\\') to[written++] = '\\';
+        to[written++] = from[i];
+    }
+    to[written] = '\0';
+    return written;
+}
+
+// ---- Text protocol --------------------------------------------------------
+
+int mysql_real_query(MYSQL* mysql, const char* query, unsigned long length) {
+    ++server.requests;
+    server.lastStatement.assign(query, length);
+    mysql->hasResult = isSelect(server.lastStatement);
+    mysql->affected = mysql->hasResult ? 0 : server.affectedRows;
+    return 0;
+}
+
+unsigned int mysql_field_count(MYSQL* mysql) {
+    return mysql->hasResult ? 1 : 0;
+}
+
+my_ulonglong mysql_affected_rows(MYSQL* mysql) {
+    return mysql->affected;
+}
+
+MYSQL_RES* mysql_store_result(MYSQL* mysql) {
+    if (!mysql->hasResult) return nullptr;
+    mysql->hasResult = false;
+    MYSQL_RES* result = new st_mysql_res();
+    result->rows = server.rows;
+    return result;
+}
+
+MYSQL_ROW mysql_fetch_row(MYSQL_RES* result) {
+    if (result->next == result->rows.size()) return nullptr;
+    std::vector<std::string>& values = result->rows[result->next++];
+    result->row.clear();
+    for (std::string& value : values) result->row.push_back(&value[0]);
+    return result->row.data();
+}
+
+my_ulonglong mysql_num_rows(MYSQL_RES* result) {
+    return result->rows.size();
+}
+
+void mysql_free_result(MYSQL_RES* result) {
+    delete result;
+}
+
+// ---- Prepared statements --------------------------------------------------
+
+MYSQL_STMT* mysql_stmt_init(MYSQL*) {
+    return new st_mysql_stmt();
+}
+
+int mysql_stmt_prepare(MYSQL_STMT* stmt, const char* query, unsigned long length) {
+    ++server.requests;
+    stmt->sql.assign(query, length);
+    stmt->select = isSelect(stmt->sql);
+    return 0;
+}
+
+my_bool mysql_stmt_bind_param(MYSQL_STMT*, MYSQL_BIND*) {
+    return false;
+}
+
+my_bool mysql_stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* bind) {
+    stmt->result = bind;
+    return false;
+}
+
+int mysql_stmt_execute(MYSQL_STMT* stmt) {
+    ++server.requests;
+    server.lastStatement = stmt->sql;
+    stmt->next = 0;
+    if (stmt->select) {
+        stmt->rows = server.rows;
+        stmt->affected = 0;
+    }
+    else {
+        stmt->rows.clear();
+        stmt->affected = server.affectedRows;
+    }
+    return 0;
+}
+
+int mysql_stmt_store_result(MYSQL_STMT*) {
+    return 0;
+}
+
+int mysql_stmt_fetch(MYSQL_STMT* stmt) {
+    if (stmt->next == stmt->rows.size()) return MYSQL_NO_DATA;
+    const std::vector<std::string>& values = stmt->rows[stmt->next++];
+    bool whole = true;
+    for (size_t c = 0; c < values.size(); ++c) {
+        if (!store(values[c], stmt->result[c])) whole = false;
+    }
+    return whole ? 0 : MYSQL_DATA_TRUNCATED;
+}
+
+int mysql_stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind, unsigned int column, unsigned long) {
+    if (stmt->next == 0) return 1;
+    store(stmt->rows[stmt->next - 1][column], *bind);
+    return 0;
+}
+
+unsigned int mysql_stmt_field_count(MYSQL_STMT* stmt) {
+    return stmt->select ? 1 : 0;
+}
+
+my_ulonglong mysql_stmt_affected_rows(MYSQL_STMT* stmt) {
+    return stmt->select ? stmt->rows.size() : stmt->affected;
+}
+
+my_bool mysql_stmt_free_result(MYSQL_STMT* stmt) {
+    stmt->rows.clear();
+    stmt->next = 0;
+    return false;
+}
+
+my_bool mysql_stmt_close(MYSQL_STMT* stmt) {
+    delete stmt;
+    return false;
+}
+
+unsigned int mysql_stmt_errno(MYSQL_STMT*) {
+    return 0;
+}
+
+const char* mysql_stmt_error(MYSQL_STMT*) {
+    return "";
+}
@@ -0,0 +1,80 @@
+#ifndef FAKE_MYSQL_H
+#define FAKE_MYSQL_H
+
+// The part of the MySQL C API that DatabaseManager and MySqlStorage use,
+// answered in memory by fake_mysql.cpp (see Fake_Server.h). Only what those
+// two files touch is declared; the layouts are not the real library's.
+
+typedef bool my_bool;
+typedef unsigned long long my_ulonglong;
+
+typedef struct st_mysql MYSQL;
+typedef struct st_mysql_res MYSQL_RES;
+typedef struct st_mysql_stmt MYSQL_STMT;
+typedef char** MYSQL_ROW;
+
+#define CLIENT_FOUND_ROWS 2
+
+#define MYSQL_NO_DATA 100
+#define MYSQL_DATA_TRUNCATED 101
+
+enum enum_field_types {
+    MYSQL_TYPE_NULL,
+    MYSQL_TYPE_LONG,
+    MYSQL_TYPE_DOUBLE,
+    MYSQL_TYPE_STRING,
+    MYSQL_TYPE_DATETIME
+};
+
+typedef struct MYSQL_TIME {
+    unsigned int year, month, day, hour, minute, second;
+    unsigned long second_part;
+} MYSQL_TIME;
+
+typedef struct MYSQL_BIND {
+    unsigned long* length;
+    my_bool* is_null;
+    void* buffer;
+    my_bool* error;
+    enum enum_field_types buffer_type;
+    unsigned long buffer_length;
+    my_bool is_unsigned;
+} MYSQL_BIND;
+
+int mysql_library_init(int argc, char** argv, char** groups);
+my_bool mysql_thread_init(void);
+void mysql_thread_end(void);
+
+MYSQL* mysql_init(MYSQL* mysql);
+MYSQL* mysql_real_connect(MYSQL* mysql, const char* host, const char* user, const char* passwd,
+    const char* db, unsigned int port, const char* unix_socket, unsigned long clientflag);
+void mysql_close(MYSQL* mysql);
+int mysql_ping(MYSQL* mysql);
+unsigned long mysql_thread_id(MYSQL* mysql);
+const char* mysql_error(MYSQL* mysql);
+unsigned long mysql_real_escape_string(MYSQL* mysql, char* to, const char* from, unsigned long length);
+
+int mysql_real_query(MYSQL* mysql, const char* query, unsigned long length);
+unsigned int mysql_field_count(MYSQL* mysql);
+my_ulonglong mysql_affected_rows(MYSQL* mysql);
+MYSQL_RES* mysql_store_result(MYSQL* mysql);
+MYSQL_ROW mysql_fetch_row(MYSQL_RES* result);
+my_ulonglong mysql_num_rows(MYSQL_RES* result);
+void mysql_free_result(MYSQL_RES* result);
+
+MYSQL_STMT* mysql_stmt_init(MYSQL* mysql);
+int mysql_stmt_prepare(MYSQL_STMT* stmt, const char* query, unsigned long length);
+my_bool mysql_stmt_bind_param(MYSQL_STMT* stmt, MYSQL_BIND* bind);
+my_bool mysql_stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* bind);
+int mysql_stmt_execute(MYSQL_STMT* stmt);
+int mysql_stmt_store_result(MYSQL_STMT* stmt);
+int mysql_stmt_fetch(MYSQL_STMT* stmt);
+int mysql_stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind, unsigned int column, unsigned long offset);
+unsigned int mysql_stmt_field_count(MYSQL_STMT* stmt);
+my_ulonglong mysql_stmt_affected_rows(MYSQL_STMT* stmt);
+my_bool mysql_stmt_free_result(MYSQL_STMT* stmt);
+my_bool mysql_stmt_close(MYSQL_STMT* stmt);
+unsigned int mysql_stmt_errno(MYSQL_STMT* stmt);
+const char* mysql_stmt_error(MYSQL_STMT* stmt);
+
+#endif
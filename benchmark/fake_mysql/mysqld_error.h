@@ -0,0 +1,6 @@
+#ifndef FAKE_MYSQLD_ERROR_H
+#define FAKE_MYSQLD_ERROR_H
+
+#define ER_DUP_ENTRY 1062
+
+#endif
@@ -0,0 +1,186 @@
+// Calculator::calculateBatch specializations: double vs float for every
+// AC / road combination (grades within 30%, within 5%, and flat), with the
+// float error against double, then a check of the double batch against
+// calculate(), then a single-vehicle batch with per-mission vehicle arrays
+// vs. precomputed VehicleCoefficients. Exits with 1 when either precision
+// leaves its tolerance.
+//
+// Built by CMakeLists.txt in this directory, without MySQL:
+//   cmake -S benchmark -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench --target kernel_benchmark
+
+#include "Calculator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    template <typename F>
+    double nsPerOp(size_t ops, int repeats, F&& body) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto stop = std::chrono::steady_clock::now();
+            best = (std::min)(best, std::chrono::duration<double, std::nano>(stop - start).count() / ops);
+        }
+        return best;
+    }
+
+    volatile double sink;
+}
+
+int main() {
+    const size_t N = 1 << 20;
+    const int repeats = 7;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    std::vector<double> mass(N), cd(N), area(N), tire(N), power(N),
+        grad(N), mild(N), flat(N, 0.0), rough(N), temp(N), dist(N), speed(N);
+    std::unique_ptr<bool[]> ac(new bool[N]);
+    for (size_t i = 0; i < N; ++i) {
+        mass[i] = 800 + u(rng) * 39200;
+        cd[i] = 0.3 + u(rng) * 0.5;
+        area[i] = 2.2 + u(rng) * 7.0;
+        tire[i] = 1.5 + u(rng) * 7.5;
+        power[i] = 90 + u(rng) * 350;
+        grad[i] = -0.3 + u(rng) * 0.6;
+        mild[i] = -0.05 + u(rng) * 0.1;
+        rough[i] = 0.005 + u(rng) * 2.495;
+        temp[i] = -30 + u(rng) * 80;
+        dist[i] = 5 + u(rng) * 400;
+        speed[i] = 5 + u(rng) * 145;
+        ac[i] = u(rng) < 0.5;
+    }
+
+    std::vector<double> outDouble(N), outFloat(N);
+    Calculator calculator;
+
+    std::cout << std::left << std::setw(28) << "kernel"
+        << std::right << std::setw(13) << "double" << std::setw(13) << "float"
+        << std::setw(10) << "speedup" << std::setw(16) << "max rel error\n";
+
+    double worstError = 0.0;
+    for (int withAC = 1; withAC >= 0; --withAC) {
+        for (int road = 0; road <= 2; ++road) {
+            MissionBatch batch;
+            batch.count = N;
+            batch.massKg = mass.data(); batch.dragCoef = cd.data(); batch.frontalArea = area.data();
+            batch.tirePressureBar = tire.data(); batch.engineRatedPower = power.data();
+            batch.hasAC = withAC ? ac.get() : nullptr;
+            batch.roadGradient = road == 0 ? grad.data() : (road == 1 ? mild.data() : flat.data());
+            batch.surfaceRoughness = rough.data(); batch.ambientTempC = temp.data();
+            batch.distanceKm = dist.data(); batch.avgSpeedKmh = speed.data();
+
+            double nsDouble = nsPerOp(N, repeats, [&] {
+                calculator.calculateBatch(batch, outDouble.data());
+                sink = outDouble[N / 2];
+            });
+            double nsFloat = nsPerOp(N, repeats, [&] {
+                calculator.calculateBatch(batch, outFloat.data(), Calculator::Precision::FLOAT);
+                sink = outFloat[N / 2];
+            });
+
+            double maxError = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                maxError = (std::max)(maxError, std::fabs(outFloat[i] - outDouble[i]) / std::fabs(outDouble[i]));
+            }
+            worstError = (std::max)(worstError, maxError);
+
+            const char* roads[] = { ", graded", ", grades within 5%", ", flat" };
+            std::string name = std::string(withAC ? "AC" : "no AC") + roads[road];
+            std::cout << std::left << std::setw(28) << name
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(10) << nsDouble << " ns"
+                << std::setw(10) << nsFloat << " ns"
+                << std::setw(9) << (nsDouble / nsFloat) << "x"
+                << std::scientific << std::setw(15) << maxError << "\n";
+        }
+    }
+
+    // The double batch against the scalar calculate() it stands in for
+    MissionBatch graded;
+    graded.count = N;
+    graded.massKg = mass.data(); graded.dragCoef = cd.data(); graded.frontalArea = area.data();
+    graded.tirePressureBar = tire.data(); graded.engineRatedPower = power.data();
+    graded.hasAC = ac.get(); graded.roadGradient = grad.data();
+    graded.surfaceRoughness = rough.data(); graded.ambientTempC = temp.data();
+    graded.distanceKm = dist.data(); graded.avgSpeedKmh = speed.data();
+    calculator.calculateBatch(graded, outDouble.data());
+
+    double batchError = 0.0;
+    Environment environment;
+    for (size_t i = 0; i < N; ++i) {
+        Vehicle vehicle("BENCH", mass[i], cd[i], area[i], power[i]);
+        vehicle.setTirePressure(tire[i]);
+        vehicle.setHasAC(ac[i]);
+        environment.setRawEnvironment(grad[i], rough[i], temp[i]);
+        double reference = calculator.calculate(vehicle, environment, dist[i], speed[i]);
+        batchError = (std::max)(batchError, std::fabs(outDouble[i] - reference) / std::fabs(reference));
+    }
+    std::cout << "\nDouble batch vs calculate(), AC, graded: max rel error "
+        << std::scientific << std::setprecision(2) << batchError << "\n";
+
+    // One vehicle for every mission: the same values passed as arrays, where
+    // the kernel derives the vehicle terms per mission, or as coefficients
+    Vehicle truck("BENCH", 18000, 0.6, 8.0, 320);
+    truck.setTirePressure(7.5);
+    VehicleCoefficients coefficients = truck.currentCoefficients();
+    std::fill(mass.begin(), mass.end(), truck.massKg);
+    std::fill(cd.begin(), cd.end(), truck.dragCoef);
+    std::fill(area.begin(), area.end(), truck.frontalArea);
+    std::fill(tire.begin(), tire.end(), truck.tirePressureBar);
+    std::fill(power.begin(), power.end(), truck.engineRatedPower);
+
+    MissionBatch arrays;
+    arrays.count = N;
+    arrays.massKg = mass.data(); arrays.dragCoef = cd.data(); arrays.frontalArea = area.data();
+    arrays.tirePressureBar = tire.data(); arrays.engineRatedPower = power.data();
+    arrays.hasAC = ac.get(); arrays.roadGradient = grad.data();
+    arrays.surfaceRoughness = rough.data(); arrays.ambientTempC = temp.data();
+    arrays.distanceKm = dist.data(); arrays.avgSpeedKmh = speed.data();
+
+    MissionBatch shared = arrays;
+    shared.massKg = shared.dragCoef = shared.frontalArea = shared.tirePressureBar = shared.engineRatedPower = nullptr;
+    shared.vehicle = &coefficients;
+
+    std::cout << "\nSame vehicle, AC, graded\n";
+    for (int precision = 0; precision <= 1; ++precision) {
+        Calculator::Precision p = precision ? Calculator::Precision::FLOAT : Calculator::Precision::DOUBLE;
+        double nsArrays = nsPerOp(N, repeats, [&] {
+            calculator.calculateBatch(arrays, outDouble.data(), p);
+            sink = outDouble[N / 2];
+        });
+        double nsShared = nsPerOp(N, repeats, [&] {
+            calculator.calculateBatch(shared, outFloat.data(), p);
+            sink = outFloat[N / 2];
+        });
+        double maxDiff = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            maxDiff = (std::max)(maxDiff, std::fabs(outFloat[i] - outDouble[i]) / std::fabs(outDouble[i]));
+        }
+        std::cout << std::left << std::setw(28) << (precision ? "  float" : "  double")
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << nsArrays << " ns arrays"
+            << std::setw(10) << nsShared << " ns coefficients"
+            << std::setw(9) << (nsArrays / nsShared) << "x"
+            << std::scientific << std::setw(15) << maxDiff << "\n";
+    }
+
+    std::cout << "\nWorst float error " << std::scientific << std::setprecision(2) << worstError
+        << " (tolerance " << Calculator::FLOAT_REL_TOLERANCE << ")\n";
+    std::cout << "Double batch error " << batchError
+        << " (tolerance " << Calculator::BATCH_REL_TOLERANCE << ")\n";
+
+    bool withinTolerance = worstError <= Calculator::FLOAT_REL_TOLERANCE
+        && batchError <= Calculator::BATCH_REL_TOLERANCE;
+    return withinTolerance ? 0 : 1;
+}
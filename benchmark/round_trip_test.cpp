@@ -0,0 +1,181 @@
+// Server round trips per Vehicle, CalculationHistory and Auth operation.
+//
+// Runs each operation through MySqlStorage and DatabaseManager against the
+// in-memory client in fake_mysql/, so no server is needed, and counts the
+// round trips twice: as DatabaseManager logs them in its QueryLog and as the
+// fake client sees them. Each operation runs once beforehand so its
+// statements are already prepared, as they are on a connection in use.
+// Exits with 1 when a count differs from the expected one.
+//
+// Auth is Windows-only (it hashes with CryptoAPI), so its rows time the
+// single Storage call each Auth operation makes (see authentication.cpp).
+//
+//   cmake -S benchmark -B build-bench && cmake --build build-bench
+//   ctest --test-dir build-bench
+
+#include "Fake_Server.h"
+#include "Database_Manager.h"
+#include "Mysql_Storage.h"
+#include "Vehicle.h"
+#include "Vehicle_Catalog.h"
+#include "Calculation_History.h"
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct Case {
+        const char* name;
+        uint64_t expected;
+        std::function<bool()> run;   // true if the operation took the intended path
+    };
+
+    uint64_t loggedRoundTrips(const DatabaseManager& db) {
+        uint64_t total = 0;
+        for (const QueryLog::Summary& s : db.queryStats().summaries()) total += s.roundTrips;
+        return total;
+    }
+
+    const std::vector<std::string> VEHICLE_ROW = {
+        "VEH-1", "Hauler", "8.5", "12000", "0.6", "8.5", "300", "2.4", "1"
+    };
+
+    std::vector<std::string> recordRow(const std::string& owner) {
+        return { "42", owner, "VEH-1", "Convoy", "12000", "0.6", "8.5", "2.4", "300", "1",
+            "8.5", "0.02", "0.015", "25", "101325", "120", "60", "38.5", "0.64", "2026-01-15 08:30:00" };
+    }
+
+}
+
+int main() {
+    DatabaseManager db;
+    db.setPoolLimits(0, 4);
+    if (!db.connect("fake", "user", "", "workshop", 3306)) return 1;
+    MySqlStorage storage(&db);
+
+    Vehicle editor(&storage);
+    VehicleCatalog catalog(&storage);
+    catalog.reset({ Vehicle("VEH-1", 12000, 0.6, 8.5, 300) });
+    Vehicle cataloged(&storage);
+    cataloged.setCatalog(&catalog);
+
+    CalculationHistory history(&storage);
+    UserAccount account;
+
+    auto affects = [](uint64_t rows) { FakeServer::setRows({}); FakeServer::setAffectedRows(rows); };
+    auto returns = [](const std::vector<std::vector<std::string>>& rows) { FakeServer::setRows(rows); };
+
+    std::vector<Case> cases = {
+        { "Vehicle::loadVehicle", 1, [&] {
+            returns({ VEHICLE_ROW });
+            return editor.loadVehicle("VEH-1");
+        } },
+        { "Vehicle::addVehicle", 1, [&] {
+            affects(1);
+            return editor.addVehicle("VEH-2", "Tanker", 7.0, 15000, 0.65, 9.0, 350);
+        } },
+        { "Vehicle::updateVehicle", 1, [&] {
+            affects(1);
+            return editor.updateVehicle("VEH-1", "", 0, 12500, 0, 0, 0, 0, true);
+        } },
+        { "Vehicle::updateVehicle, no such id", 1, [&] {
+            affects(0);
+            return !editor.updateVehicle("VEH-9", "", 0, 12500, 0, 0, 0, 0, true);
+        } },
+        { "Vehicle::deleteVehicle", 1, [&] {
+            affects(1);
+            return editor.deleteVehicle("VEH-2");
+        } },
+        { "Vehicle::loadVehicle, catalog", 0, [&] {
+            return cataloged.loadVehicle("VEH-1");
+        } },
+        { "Vehicle::addVehicle, catalog", 1, [&] {
+            affects(1);
+            return cataloged.addVehicle("VEH-2", "Tanker", 7.0, 15000, 0.65, 9.0, 350);
+        } },
+        { "Vehicle::updateVehicle, catalog", 1, [&] {
+            affects(1);
+            return cataloged.updateVehicle("VEH-1", "", 0, 12500, 0, 0, 0, 0, true);
+        } },
+        { "Vehicle::deleteVehicle, catalog", 1, [&] {
+            affects(1);
+            return cataloged.deleteVehicle("VEH-2");
+        } },
+
+        { "CalculationHistory::getCalculationById", 1, [&] {
+            returns({ recordRow("alice") });
+            return history.getCalculationById(42).id == 42;
+        } },
+        { "CalculationHistory::deleteCalculation", 1, [&] {
+            affects(1);
+            return history.deleteCalculation(42, "alice");
+        } },
+        // Only a refused delete reads the row back, to say why
+        { "CalculationHistory::deleteCalculation, not owner", 2, [&] {
+            affects(0);
+            returns({ recordRow("bob") });
+            return !history.deleteCalculation(42, "alice");
+        } },
+
+        { "Auth::login / verify (findUser)", 1, [&] {
+            returns({ { "salt:hash", "admin" } });
+            return storage.findUser("alice", account) && account.role == "admin";
+        } },
+        { "Auth::registerUser (insertUser)", 1, [&] {
+            affects(1);
+            return storage.insertUser({ "carol", "salt:hash", "user" }) == 1;
+        } },
+        { "Auth::updateUser (updatePasswordHash)", 1, [&] {
+            affects(1);
+            return storage.updatePasswordHash("alice", "salt:hash2") == 1;
+        } },
+        { "Auth::changeUserRole (updateRole)", 1, [&] {
+            affects(1);
+            return storage.updateRole("alice", "user") == 1;
+        } },
+        { "Auth::deleteUser (deleteUser)", 1, [&] {
+            affects(1);
+            return storage.deleteUser("carol") == 1;
+        } },
+    };
+
+    std::cout << std::left << std::setw(52) << "operation"
+        << std::right << std::setw(10) << "expected" << std::setw(8) << "logged"
+        << std::setw(8) << "sent" << "  status\n";
+
+    int failures = 0;
+    std::ostringstream discarded;
+    for (const Case& c : cases) {
+        // The components report every step on std::cout
+        std::streambuf* console = std::cout.rdbuf(discarded.rdbuf());
+        c.run();
+        uint64_t loggedBefore = loggedRoundTrips(db);
+        uint64_t sentBefore = FakeServer::requests();
+        bool tookPath = c.run();
+        uint64_t logged = loggedRoundTrips(db) - loggedBefore;
+        uint64_t sent = FakeServer::requests() - sentBefore;
+        std::cout.rdbuf(console);
+        discarded.str("");
+
+        const char* status = "ok";
+        if (!tookPath) status = "FAILED (unexpected result)";
+        else if (logged != c.expected || sent != c.expected) status = "FAILED";
+        if (status[0] != 'o') ++failures;
+
+        std::cout << std::left << std::setw(52) << c.name
+            << std::right << std::setw(10) << c.expected << std::setw(8) << logged
+            << std::setw(8) << sent << "  " << status << "\n";
+    }
+
+    if (failures > 0) {
+        std::cout << "\n" << failures << " operation(s) did not make the expected round trips\n";
+        return 1;
+    }
+    std::cout << "\nAll operations made the expected round trips\n";
+    return 0;
+}
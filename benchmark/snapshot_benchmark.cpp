@@ -0,0 +1,76 @@
+// ReferenceSnapshot: time from nothing to the first lookup, and lookup cost
+// once mapped, for a calculation-only process that has no database.
+//
+//   ./build-bench/snapshot_benchmark [vehicles]
+
+#include "Reference_Snapshot.h"
+#include "Snapshot_Storage.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t lookups = 1000000;
+    const int repeats = 5;
+    const std::string path = "snapshot_benchmark.snap";
+
+    ReferenceData data;
+    data.vehicles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Vehicle v("VH" + std::to_string(i), 1200.0 + i % 800, 0.28 + (i % 20) * 0.01, 2.1, 90.0 + i % 200);
+        v.model_name = "Model " + std::to_string(i % 97);
+        v.efficiency = 6.5;
+        data.vehicles.push_back(v);
+    }
+    for (int i = 0; i < 50; ++i) {
+        MissionPreset p;
+        p.name = "preset" + std::to_string(i);
+        p.roadGradient = i * 0.1;
+        data.presets.push_back(p);
+    }
+    data.hasFuelPrice = true;
+    data.fuelPrice = 1.85;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!ReferenceSnapshot::write(path, data, 1)) return 1;
+    double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Open includes the checksum pass over the whole file
+    double openBest = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        start = std::chrono::steady_clock::now();
+        SnapshotStorage storage(path, nullptr);
+        Vehicle first(nullptr);
+        if (!storage.open() || !storage.loadVehicle("VH0", first)) return 1;
+        openBest = (std::min)(openBest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    SnapshotStorage storage(path, nullptr);
+    if (!storage.open()) return 1;
+    std::vector<std::string> ids(4096);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = "VH" + std::to_string((i * 7919) % count);
+    }
+    Vehicle found(nullptr);
+    size_t hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        hits += storage.loadVehicle(ids[i % ids.size()], found);
+    }
+    double lookupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Vehicles:        " << count << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Write:           " << writeSeconds * 1e3 << " ms\n";
+    std::cout << "Open + 1 lookup: " << openBest * 1e3 << " ms\n";
+    std::cout << "Lookup:          " << lookupSeconds / lookups * 1e9 << " ns (" << hits << " hits)\n";
+
+    std::remove(path.c_str());
+    return 0;
+}
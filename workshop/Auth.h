@@ -3,18 +3,18 @@
 
 #include <string>
 #include <vector>
-#include "Database_Manager.h"
+#include "Storage.h"
 
 class Auth {
 public:
     enum class Role { USER, ADMIN };
 
-    Auth(DatabaseManager* db);
+    Auth(Storage* storage);
 
     // Authentication
     bool login(std::string& loggedInUser, Role& loggedInRole);
 
-    // Database operations
+    // Account operations
     bool registerUser(const std::string& username, const std::string& password, Role role = Role::USER);
     bool updateUser(const std::string& currentUser, Role currentRole,const std::string& targetUser, const std::string& newPassword);
     bool deleteUser(const std::string& currentUser, Role currentRole, const std::string& targetUser);
@@ -32,7 +32,7 @@ public:
     bool userExists(const std::string& username); 
 
 private:
-    DatabaseManager* db;
+    Storage* storage;
     void setEcho(bool enable);
     static std::string generateSalt(size_t length = 32);
     static std::string hashPassword(const std::string& password, const std::string& salt);
@@ -0,0 +1,297 @@
+#ifndef BATCH_LANES_H
+#define BATCH_LANES_H
+
+#include "Efficiency_Table.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Lane types shared by the batch kernels (calculator_batch.cpp,
+// drive_cycle.cpp). A kernel is written once against the interface below and
+// instantiated per lane type:
+//
+//   Vec                 value type, with + - * /
+//   WIDTH               missions per Vec
+//   load / store        from / to `double` arrays (float lanes narrow in registers)
+//   Wide                double lanes covering the same missions in
+//                       WIDTH / Wide::WIDTH parts, for sums that cancel
+//   widen(v, part)      that part of v as Wide::Vec
+//   narrow(parts)       the parts back as one Vec
+//   set1, max, sqrt
+//   greater(a, b)       bit k set where lane k of a > b
+//   tireFactor(p)       pow(p, -0.477)
+//   efficiency(x)       EfficiencyTable lookup, clamped
+//   acPower(flags, t)   4000 W where the AC flag is set and t > 20 C
+//
+// Internal to the calculation sources; not part of the Calculator interface.
+namespace BatchLanes {
+
+    // Plain double or float, one mission at a time
+    template <typename T>
+    struct ScalarLanes {
+        using Vec = T;
+        static constexpr size_t WIDTH = 1;
+
+        static Vec load(const double* p) { return static_cast<T>(*p); }
+        static void store(double* p, Vec v) { *p = static_cast<double>(v); }
+        static Vec set1(double x) { return static_cast<T>(x); }
+
+        using Wide = ScalarLanes<double>;
+        static double widen(Vec v, size_t) { return static_cast<double>(v); }
+        static Vec narrow(const double* parts) { return static_cast<T>(parts[0]); }
+
+        static Vec max(Vec a, Vec b) { return a > b ? a : b; }
+        static Vec sqrt(Vec a) { return std::sqrt(a); }
+        static int greater(Vec a, Vec b) { return a > b ? 1 : 0; }
+        static Vec tireFactor(Vec pressure) { return std::pow(pressure, static_cast<T>(-0.477)); }
+
+        static Vec efficiency(Vec loadFactor) {
+            if constexpr (sizeof(T) == sizeof(float)) return EfficiencyTable::lookupF(loadFactor);
+            else return EfficiencyTable::lookup(loadFactor);
+        }
+
+        static Vec acPower(const bool* hasAC, Vec tempC) {
+            return (*hasAC && tempC > static_cast<T>(20.0)) ? static_cast<T>(4000.0) : static_cast<T>(0.0);
+        }
+    };
+
+#if defined(__AVX2__)
+
+    struct D4 { __m256d v; };
+    inline D4 operator+(D4 a, D4 b) { return { _mm256_add_pd(a.v, b.v) }; }
+    inline D4 operator-(D4 a, D4 b) { return { _mm256_sub_pd(a.v, b.v) }; }
+    inline D4 operator*(D4 a, D4 b) { return { _mm256_mul_pd(a.v, b.v) }; }
+    inline D4 operator/(D4 a, D4 b) { return { _mm256_div_pd(a.v, b.v) }; }
+
+    struct F8 { __m256 v; };
+    inline F8 operator+(F8 a, F8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+    inline F8 operator-(F8 a, F8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    inline F8 operator*(F8 a, F8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    inline F8 operator/(F8 a, F8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+
+    // log(x) for finite x > 0
+    inline __m256d log_pd(__m256d x) {
+        const __m256i mantMask = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+        const __m256i oneBits = _mm256_set1_epi64x(0x3FF0000000000000LL);
+        const __m256d twoPow52 = _mm256_set1_pd(4503599627370496.0);
+
+        __m256i bits = _mm256_castpd_si256(x);
+
+        // Exponent field converted to double via the 2^52 bias trick
+        __m256i expField = _mm256_srli_epi64(bits, 52);
+        __m256d e = _mm256_sub_pd(
+            _mm256_castsi256_pd(_mm256_or_si256(expField, _mm256_castpd_si256(twoPow52))),
+            twoPow52);
+        e = _mm256_sub_pd(e, _mm256_set1_pd(1023.0));
+
+        // Mantissa in [1, 2), folded into [sqrt(0.5), sqrt(2))
+        __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, mantMask), oneBits));
+        __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+        m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+        e = _mm256_add_pd(e, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+        // log(m) = 2 * atanh(f), f = (m - 1) / (m + 1), |f| < 0.1716
+        __m256d one = _mm256_set1_pd(1.0);
+        __m256d f = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+        __m256d s = _mm256_mul_pd(f, f);
+
+        __m256d p = _mm256_set1_pd(1.0 / 25.0);
+        for (int k = 11; k >= 0; --k) {
+            p = _mm256_add_pd(_mm256_mul_pd(p, s), _mm256_set1_pd(1.0 / (2 * k + 1)));
+        }
+        __m256d logm = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), f), p);
+
+        const __m256d ln2Hi = _mm256_set1_pd(6.93147180369123816490e-01);
+        const __m256d ln2Lo = _mm256_set1_pd(1.90821492927058770002e-10);
+        return _mm256_add_pd(_mm256_mul_pd(e, ln2Hi),
+            _mm256_add_pd(logm, _mm256_mul_pd(e, ln2Lo)));
+    }
+
+    // exp(y) for |y| well inside the double range
+    inline __m256d exp_pd(__m256d y) {
+        const __m256d log2e = _mm256_set1_pd(1.4426950408889634);
+        const __m256d ln2Hi = _mm256_set1_pd(6.93147180369123816490e-01);
+        const __m256d ln2Lo = _mm256_set1_pd(1.90821492927058770002e-10);
+        const __m256d roundMagic = _mm256_set1_pd(6755399441055744.0); // 2^52 + 2^51
+
+        __m256d n = _mm256_round_pd(_mm256_mul_pd(y, log2e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256d r = _mm256_sub_pd(_mm256_sub_pd(y, _mm256_mul_pd(n, ln2Hi)), _mm256_mul_pd(n, ln2Lo));
+
+        // Taylor series to degree 13, |r| <= ln2 / 2
+        __m256d p = _mm256_set1_pd(1.0 / 6227020800.0);
+        double coef = 6227020800.0;
+        for (int k = 12; k >= 0; --k) {
+            coef /= (k + 1);
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / coef));
+        }
+
+        // Scale by 2^n
+        __m256i ni = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n, roundMagic)),
+            _mm256_castpd_si256(roundMagic));
+        __m256i scaleBits = _mm256_slli_epi64(_mm256_add_epi64(ni, _mm256_set1_epi64x(1023)), 52);
+        return _mm256_mul_pd(p, _mm256_castsi256_pd(scaleBits));
+    }
+
+    // Single-precision log(x), x > 0: same reduction, shorter series
+    inline __m256 log_ps(__m256 x) {
+        __m256i bits = _mm256_castps_si256(x);
+        __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+
+        __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+            _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+        __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+        m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+        e = _mm256_add_ps(e, _mm256_and_ps(big, _mm256_set1_ps(1.0f)));
+
+        __m256 one = _mm256_set1_ps(1.0f);
+        __m256 f = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        __m256 s = _mm256_mul_ps(f, f);
+
+        __m256 p = _mm256_set1_ps(1.0f / 13.0f);
+        for (int k = 5; k >= 0; --k) {
+            p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(1.0f / (2 * k + 1)));
+        }
+        __m256 logm = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), f), p);
+
+        return _mm256_add_ps(_mm256_mul_ps(e, _mm256_set1_ps(0.693147181f)), logm);
+    }
+
+    // Single-precision exp(y)
+    inline __m256 exp_ps(__m256 y) {
+        __m256 n = _mm256_round_ps(_mm256_mul_ps(y, _mm256_set1_ps(1.44269504f)),
+            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256 r = _mm256_sub_ps(_mm256_sub_ps(y, _mm256_mul_ps(n, _mm256_set1_ps(0.693359375f))),
+            _mm256_mul_ps(n, _mm256_set1_ps(-2.12194440e-4f)));
+
+        // Taylor series to degree 7
+        __m256 p = _mm256_set1_ps(1.0f / 5040.0f);
+        float coef = 5040.0f;
+        for (int k = 6; k >= 0; --k) {
+            coef /= (k + 1);
+            p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / coef));
+        }
+
+        __m256i scaleBits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+        return _mm256_mul_ps(p, _mm256_castsi256_ps(scaleBits));
+    }
+
+    struct AvxDoubleLanes {
+        using Vec = D4;
+        static constexpr size_t WIDTH = 4;
+
+        static Vec load(const double* p) { return { _mm256_loadu_pd(p) }; }
+        static void store(double* p, Vec v) { _mm256_storeu_pd(p, v.v); }
+        static Vec set1(double x) { return { _mm256_set1_pd(x) }; }
+
+        using Wide = AvxDoubleLanes;
+        static Vec widen(Vec v, size_t) { return v; }
+        static Vec narrow(const Vec* parts) { return parts[0]; }
+
+        static Vec max(Vec a, Vec b) { return { _mm256_max_pd(a.v, b.v) }; }
+        static Vec sqrt(Vec a) { return { _mm256_sqrt_pd(a.v) }; }
+        static int greater(Vec a, Vec b) { return _mm256_movemask_pd(_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)); }
+        static Vec tireFactor(Vec pressure) {
+            return { exp_pd(_mm256_mul_pd(_mm256_set1_pd(-0.477), log_pd(pressure.v))) };
+        }
+
+        // Vector form of EfficiencyTable::lookup
+        static Vec efficiency(Vec loadFactor) {
+            using namespace EfficiencyTable;
+
+            __m256d x = _mm256_min_pd(_mm256_max_pd(loadFactor.v, _mm256_set1_pd(X_MIN)), _mm256_set1_pd(X_MAX));
+            __m256d pos = _mm256_mul_pd(_mm256_sub_pd(x, _mm256_set1_pd(X_MIN)), _mm256_set1_pd(INV_STEP));
+            __m256d idxD = _mm256_min_pd(_mm256_floor_pd(pos), _mm256_set1_pd(static_cast<double>(SIZE - 2)));
+            __m256d frac = _mm256_sub_pd(pos, idxD);
+
+            // Masked gathers with a zeroed source: the unmasked forms read an
+            // uninitialized source inside the intrinsic (-Wmaybe-uninitialized)
+            __m128i idx = _mm256_cvttpd_epi32(idxD);
+            __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            __m256d lo = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), TABLE.values, idx, all, 8);
+            __m256d hi = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), TABLE.values + 1, idx, all, 8);
+
+            __m256d v = _mm256_add_pd(lo, _mm256_mul_pd(frac, _mm256_sub_pd(hi, lo)));
+            return { _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(EFF_MIN)), _mm256_set1_pd(EFF_MAX)) };
+        }
+
+        // 4000 W where the AC flag is set and the air is above 20 C
+        static Vec acPower(const bool* hasAC, Vec tempC) {
+            int32_t flags;
+            std::memcpy(&flags, hasAC, sizeof(flags));
+            __m256i wide = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(flags));
+            __m256d on = _mm256_castsi256_pd(_mm256_cmpgt_epi64(wide, _mm256_setzero_si256()));
+            __m256d hot = _mm256_cmp_pd(tempC.v, _mm256_set1_pd(20.0), _CMP_GT_OQ);
+            return { _mm256_and_pd(_mm256_and_pd(on, hot), _mm256_set1_pd(4000.0)) };
+        }
+    };
+
+    struct AvxFloatLanes {
+        using Vec = F8;
+        static constexpr size_t WIDTH = 8;
+
+        // Inputs and outputs stay double; narrowing happens in registers
+        static Vec load(const double* p) {
+            __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(p));
+            __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(p + 4));
+            return { _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1) };
+        }
+        static void store(double* p, Vec v) {
+            _mm256_storeu_pd(p, _mm256_cvtps_pd(_mm256_castps256_ps128(v.v)));
+            _mm256_storeu_pd(p + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v.v, 1)));
+        }
+        static Vec set1(double x) { return { _mm256_set1_ps(static_cast<float>(x)) }; }
+
+        using Wide = AvxDoubleLanes;
+        static D4 widen(Vec v, size_t part) {
+            return { _mm256_cvtps_pd(part == 0 ? _mm256_castps256_ps128(v.v) : _mm256_extractf128_ps(v.v, 1)) };
+        }
+        static Vec narrow(const D4* parts) {
+            __m128 lo = _mm256_cvtpd_ps(parts[0].v);
+            __m128 hi = _mm256_cvtpd_ps(parts[1].v);
+            return { _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1) };
+        }
+
+        static Vec max(Vec a, Vec b) { return { _mm256_max_ps(a.v, b.v) }; }
+        static Vec sqrt(Vec a) { return { _mm256_sqrt_ps(a.v) }; }
+        static int greater(Vec a, Vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)); }
+        static Vec tireFactor(Vec pressure) {
+            return { exp_ps(_mm256_mul_ps(_mm256_set1_ps(-0.477f), log_ps(pressure.v))) };
+        }
+
+        // Vector form of EfficiencyTable::lookupF
+        static Vec efficiency(Vec loadFactor) {
+            using namespace EfficiencyTable;
+
+            __m256 x = _mm256_min_ps(_mm256_max_ps(loadFactor.v, _mm256_set1_ps(float(X_MIN))), _mm256_set1_ps(float(X_MAX)));
+            __m256 pos = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_set1_ps(float(X_MIN))), _mm256_set1_ps(float(INV_STEP)));
+            __m256 idxF = _mm256_min_ps(_mm256_floor_ps(pos), _mm256_set1_ps(float(SIZE - 2)));
+            __m256 frac = _mm256_sub_ps(pos, idxF);
+
+            // Masked for the same reason as AvxDoubleLanes::efficiency
+            __m256i idx = _mm256_cvttps_epi32(idxF);
+            __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            __m256 lo = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), TABLE_F.values, idx, all, 4);
+            __m256 hi = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), TABLE_F.values + 1, idx, all, 4);
+
+            __m256 v = _mm256_add_ps(lo, _mm256_mul_ps(frac, _mm256_sub_ps(hi, lo)));
+            return { _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(float(EFF_MIN))), _mm256_set1_ps(float(EFF_MAX))) };
+        }
+
+        static Vec acPower(const bool* hasAC, Vec tempC) {
+            __m256i wide = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(hasAC)));
+            __m256 on = _mm256_castsi256_ps(_mm256_cmpgt_epi32(wide, _mm256_setzero_si256()));
+            __m256 hot = _mm256_cmp_ps(tempC.v, _mm256_set1_ps(20.0f), _CMP_GT_OQ);
+            return { _mm256_and_ps(_mm256_and_ps(on, hot), _mm256_set1_ps(4000.0f)) };
+        }
+    };
+
+#endif
+
+} // namespace BatchLanes
+
+#endif
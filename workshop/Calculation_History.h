@@ -3,49 +3,23 @@
 
 #include <string>
 #include <vector>
-#include <ctime>
-#include "Database_Manager.h"
-
-struct CalculationRecord {
-    int id;
-    std::string username;
-    std::string vehicle_id;
-    std::string mission_name;
-
-    // Vehicle parameters
-    double vehicle_mass;
-    double vehicle_drag_coef;
-    double vehicle_frontal_area;
-    double vehicle_tire_pressure;
-    double vehicle_engine_power;
-    bool vehicle_has_ac;
-    double vehicle_efficiency;
-
-    // Environmental parameters
-    double road_gradient;
-    double surface_roughness;
-    double ambient_temp;
-    double pressure;
-
-    // Mission parameters
-    double distance_km;
-    double avg_speed_kmh;
-
-    // Results
-    double fuel_consumed_liters;
-    double cost_per_km;
-
-    // Metadata
-    std::string calculated_at;
-
-    // Helper methods
-    std::string getFormattedDate() const;
-    double getTotalFuelCost() const;
+#include "Storage.h"
+#include "Calculation_Record.h"
+
+class ThreadPool;
+
+// One page of a newest-first history listing. The tokens are opaque keyset
+// cursors for getCalculationPage(); empty when there is nothing further in
+// that direction.
+struct CalculationPage {
+    std::vector<CalculationRecord> records;
+    std::string nextToken;  // older records
+    std::string prevToken;  // newer records
 };
 
 class CalculationHistory {
 public:
-    CalculationHistory(DatabaseManager* db);
+    CalculationHistory(Storage* storage);
 
     // CRUD Operations
     bool saveCalculation(const CalculationRecord& record);
@@ -53,6 +27,11 @@ public:
     std::vector<CalculationRecord> getRecentCalculations(int limit = 20);
     std::vector<CalculationRecord> getVehicleCalculations(const std::string& vehicle_id, int limit = 50);
     CalculationRecord getCalculationById(int calculation_id);
+    // Keyset pagination on (calculated_at, id), newest first; username empty
+    // for all users. Each page reads pageSize + 1 rows from the cursor on,
+    // however deep the token points.
+    CalculationPage getCalculationPage(const std::string& username, int pageSize,
+        const std::string& token = "");
     bool deleteCalculation(int calculation_id, const std::string& requesting_user);
     bool deleteAllUserCalculations(const std::string& username);
 
@@ -63,15 +42,16 @@ public:
 
     // Export/Import
     bool exportToCSV(const std::string& username, const std::string& filename);
+    // One file per user (prefix_username.csv), written in parallel; returns
+    // the number of files written
+    int exportAllUsersToCSV(const std::string& prefix, ThreadPool& workers);
     std::vector<CalculationRecord> searchCalculations(const std::string& username,
         const std::string& vehicle_id = "",
         const std::string& start_date = "",
         const std::string& end_date = "");
 
 private:
-    DatabaseManager* db;
-
-    CalculationRecord rowToRecord(MYSQL_ROW row);
+    Storage* storage;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef CALCULATION_RECORD_H
+#define CALCULATION_RECORD_H
+
+#include <string>
+
+struct CalculationRecord {
+    int id;
+    std::string username;
+    std::string vehicle_id;
+    std::string mission_name;
+
+    // Vehicle parameters
+    double vehicle_mass;
+    double vehicle_drag_coef;
+    double vehicle_frontal_area;
+    double vehicle_tire_pressure;
+    double vehicle_engine_power;
+    bool vehicle_has_ac;
+    double vehicle_efficiency;
+
+    // Environmental parameters
+    double road_gradient;
+    double surface_roughness;
+    double ambient_temp;
+    double pressure;
+
+    // Mission parameters
+    double distance_km;
+    double avg_speed_kmh;
+
+    // Results
+    double fuel_consumed_liters;
+    double cost_per_km;
+
+    // Metadata
+    std::string calculated_at;
+
+    // Helper methods
+    std::string getFormattedDate() const;
+    double getTotalFuelCost() const;
+
+    // Local time in the calculated_at format, "YYYY-MM-DD HH:MM:SS"
+    static std::string currentTimestamp();
+};
+
+#endif
@@ -3,17 +3,17 @@
 
 #include <string>
 
-class DatabaseManager;
+class Storage;
 
 class Cost {
 private:
     static double fuelPrice; // RM per liter
     static bool initialized;
-    DatabaseManager* db;
+    Storage* storage;
 
 public:
     // Constructors
-    Cost(DatabaseManager* dbManager = nullptr);
+    explicit Cost(Storage* storage); // loads the price once per process
     Cost();
 
     double calculate(double km_per_liter) const;
@@ -1,24 +1,195 @@
 #ifndef DATABASEMANAGER_H
 #define DATABASEMANAGER_H
 #include <mysql.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "Query_Log.h"
 using std::string;
 
+// Owns the application's MySQL connections.
+//
+// The primary connection (getConnection() on a thread without a lease) serves
+// the interactive menus, as before; like a pooled handle, it is pinged once
+// it has been idle and reopened if the server dropped it. Concurrent jobs
+// take connections from a pool of between minSize and maxSize handles with
+// acquire(); a MYSQL handle must never be used by two threads at once, so
+// each worker holds its own lease. While a thread holds a lease,
+// getConnection() on that thread returns the leased handle, so existing
+// components (CalculationHistory, Vehicle, ...) run unchanged on worker
+// threads. Work that must stay on one session, such as a transaction, takes
+// a lease too: a handle is only replaced when it is handed out.
+//
+// Prepared statements are cached per connection, keyed by SQL text, so each
+// statement is parsed by the server once per connection rather than per call.
+//
+// Statements run through execute()/fetch() (prepared) or query()/
+// queryResult() (text protocol), which time every call into a QueryLog:
+// per-statement latency histogram, rows and round trips, plus a slow-query
+// log above a configurable threshold.
 class DatabaseManager {
 public:
+    struct PoolStats {
+        size_t size = 0;          // open pooled connections
+        size_t idle = 0;
+        size_t inUse = 0;
+        size_t peakInUse = 0;
+        uint64_t acquisitions = 0;
+        uint64_t waits = 0;       // acquisitions that had to block
+        uint64_t timeouts = 0;
+        uint64_t reconnects = 0;  // handles replaced after a failed ping, primary included
+        double totalWaitMs = 0.0;
+        double maxWaitMs = 0.0;
+        uint64_t statementPrepares = 0; // server-side prepares, all connections
+        uint64_t statementReuses = 0;   // prepare() calls served from the cache
+    };
+
+    // RAII handle on a pooled connection; returns it to the pool when
+    // destroyed. Bound to the thread that acquired it.
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        MYSQL* get() const { return conn; }
+        explicit operator bool() const { return conn != nullptr; }
+        void release();
+
+    private:
+        friend class DatabaseManager;
+        Lease(DatabaseManager* owner, MYSQL* conn);
+
+        DatabaseManager* owner = nullptr;
+        MYSQL* conn = nullptr;
+        const DatabaseManager* previousOwner = nullptr; // outer lease on this thread, if any
+        MYSQL* previousConn = nullptr;
+    };
+
     DatabaseManager();
     ~DatabaseManager();
 
+    DatabaseManager(const DatabaseManager&) = delete;
+    DatabaseManager& operator=(const DatabaseManager&) = delete;
+
+    // Pool limits and the idle time after which a connection is pinged before
+    // being handed out. Call before connect().
+    void setPoolLimits(size_t minSize, size_t maxSize);
+    void setValidationInterval(std::chrono::milliseconds idleTime);
+
     bool connect(const string& host,
         const string& user,
         const string& pass,
         const string& db,
         unsigned int port);
 
+    // The calling thread's leased connection, or the primary connection
     MYSQL* getConnection();
 
+    // Blocks until a pooled connection is free (or can be opened) or the
+    // timeout expires; an empty lease means failure.
+    Lease acquire(std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
+    // Prepared statement for sql on the calling thread's connection, prepared
+    // on first use and re-prepared if the connection has since reconnected.
+    // Returns nullptr (after reporting the error) on failure. The statement
+    // belongs to the cache: end each use with finish(), never mysql_stmt_close().
+    MYSQL_STMT* prepare(const string& sql);
+
+    // Discards any unread result so the connection is ready for the next
+    // query; the statement stays cached. Accepts nullptr.
+    void finish(MYSQL_STMT* stmt);
+
+    // Timed mysql_stmt_execute / mysql_stmt_fetch for statements from
+    // prepare(). Latency is the execute round trip (up to the first row of a
+    // result); rows are counted as they are fetched and logged at finish().
+    bool execute(MYSQL_STMT* stmt);
+    int fetch(MYSQL_STMT* stmt);
+
+    // Timed text-protocol query on the calling thread's connection. SQL with
+    // literal values embedded should pass a fixed label, which is what the
+    // query log groups by. On failure mysql_error(getConnection()) has the
+    // reason. query() discards any result set; queryResult() returns it
+    // (nullptr on failure or for statements without one) for the caller to free.
+    bool query(const string& sql, const char* label = nullptr);
+    MYSQL_RES* queryResult(const string& sql, const char* label = nullptr);
+
+    // Statements taking at least `threshold` are appended to `path`
+    void setSlowQueryLog(const string& path, std::chrono::milliseconds threshold);
+    const QueryLog& queryStats() const { return queryLog; }
+    void displayQueryStats() const { queryLog.display(); }
+
+    size_t poolCapacity() const { return maxSize; }
+    PoolStats poolStats() const;
+    void displayPoolStats() const;
+
 private:
+    struct Pooled {
+        MYSQL* conn;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
     MYSQL* conn;
+    std::mutex primaryLock;
+    std::chrono::steady_clock::time_point primaryLastUsed;
+
+    // Connection parameters, kept for opening and reopening pooled handles
+    string host;
+    string user;
+    string pass;
+    string dbName;
+    unsigned int port;
+
+    size_t minSize;
+    size_t maxSize;
+    std::chrono::milliseconds validateAfter;
+
+    mutable std::mutex poolLock;
+    std::condition_variable poolReady;
+    std::vector<Pooled> idle;
+    size_t openCount;
+    PoolStats stats;
+
+    // Statements prepared on one connection. threadId is the server session
+    // they were prepared in; a reconnect changes it and invalidates them.
+    struct StatementCache {
+        unsigned long threadId = 0;
+        std::unordered_map<string, MYSQL_STMT*> statements;
+    };
+
+    // Query log counters of a cached statement, plus the result being read
+    // from it; only the thread holding the statement's connection touches
+    // the pending fields
+    struct StatementTiming {
+        QueryLog::Entry* entry = nullptr;
+        bool pending = false;
+        std::chrono::nanoseconds elapsed{ 0 };
+        uint64_t rows = 0;
+    };
+
+    mutable std::mutex statementLock;
+    std::unordered_map<MYSQL*, StatementCache> statementCaches;
+    std::unordered_map<MYSQL_STMT*, StatementTiming> statementTimings;
+    uint64_t statementPrepares;
+    uint64_t statementReuses;
+
+    QueryLog queryLog;
+
+    MYSQL* openConnection();
+    void closeConnection(MYSQL* handle);
+    void closeStatement(MYSQL_STMT* stmt);   // caller holds statementLock
+    StatementTiming* timingOf(MYSQL_STMT* stmt);
+    MYSQL_RES* runQuery(const string& sql, const char* label, bool& ok);
+    void giveBack(MYSQL* handle);
 };
 
 #endif
@@ -0,0 +1,69 @@
+#ifndef DRIVE_CYCLE_H
+#define DRIVE_CYCLE_H
+
+#include <string>
+#include <cstddef>
+#include "Vehicle.h"
+#include "Environment.h"
+
+struct DriveCycleResult {
+    size_t samples = 0;
+    double durationSec = 0.0;
+    double distanceKm = 0.0;
+    double liters = 0.0;
+    double maxAccelMs2 = 0.0;
+
+    double averageSpeedKmh() const { return durationSec > 0.0 ? distanceKm / (durationSec / 3600.0) : 0.0; }
+};
+
+// Fuel over a speed trace sampled at a fixed interval (1 Hz by default).
+//
+// Between two samples the vehicle accelerates uniformly, so each step uses
+// the mean speed and a = dv/dt, and the inertial force m*a is added to the
+// rolling, aero and grade forces of Calculator::calculate. Negative wheel
+// power (braking, coasting) is clamped to zero as in calculate(), so the
+// auxiliaries keep burning fuel while stopped. A constant-speed trace gives
+// the same figure as calculate() with that average speed.
+//
+// Samples can be fed in any number of blocks; state carries over between
+// calls, and memory use is independent of trace length.
+class DriveCycle {
+public:
+    DriveCycle(const Vehicle& vehicle, const Environment& environment, double sampleIntervalSec = 1.0);
+
+    // Batch path: the next `count` speed samples (km/h) of the trace
+    void addSamples(const double* speedKmh, size_t count);
+
+    // Streams a trace file through addSamples in fixed-size blocks.
+    // One sample per line; with several comma-separated columns (e.g.
+    // "time_s,speed_kmh") the last one is the speed. Blank lines, lines
+    // starting with '#' and a non-numeric header are skipped.
+    bool addFile(const std::string& filename);
+
+    DriveCycleResult result() const;
+    void reset();
+
+    void displayResult(const DriveCycleResult& result) const;
+
+private:
+    // Per-vehicle/environment terms, fixed for the whole trace
+    double dt;
+    double invDt;
+    double massKg;
+    double slopeForce;     // rolling + grade (N)
+    double aeroFactor;     // 0.5 * rho * Cd * A
+    double auxPowerW;
+    double invRatedPowerW;
+
+    // Integration state
+    bool havePrevious;
+    double previousKmh;
+    size_t sampleCount;
+    double powerOverEff;   // sum of P_required / efficiency over steps
+    double speedSum;       // sum of step mean speeds (m/s)
+    double maxAccel;
+
+    void integrate(const double* speedKmh, size_t count);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef EFFICIENCY_TABLE_H
+#define EFFICIENCY_TABLE_H
+
+#include <cstddef>
+
+// Engine efficiency curve used by Calculator, tabulated at compile time.
+//
+// The table samples the cubic
+//     eff(x) = 0.5968x - 0.1666x^2 + 2.4968x^3 - 2.1128 + 0.4
+// at SIZE evenly spaced load factors over [0.2, 1.0]. lookup() interpolates
+// linearly between samples and then applies the [0.30, 0.45] clamp, exactly
+// as the polynomial path did. Interpolating the unclamped cubic keeps the
+// clamp corners sharp; the only error left is curvature between samples:
+//     |error| <= STEP^2 / 8 * max|eff''| = STEP^2 / 8 * 14.6504 ~= 1.12e-6
+// (absolute, i.e. < 3.8e-6 relative to the 0.30 floor). MAX_ABS_ERROR below
+// is checked against the polynomial at every interval midpoint at compile time.
+namespace EfficiencyTable {
+
+    constexpr double X_MIN = 0.2;
+    constexpr double X_MAX = 1.0;
+    constexpr std::size_t SIZE = 1025;
+    constexpr double STEP = (X_MAX - X_MIN) / (SIZE - 1);
+    constexpr double INV_STEP = (SIZE - 1) / (X_MAX - X_MIN);
+
+    constexpr double EFF_MIN = 0.30;
+    constexpr double EFF_MAX = 0.45;
+
+    constexpr double MAX_ABS_ERROR = 1.2e-6;
+
+    // Reference curve (unclamped), also used to generate the table
+    constexpr double polynomial(double x) {
+        return 0.5968 * x - 0.1666 * x * x + 2.4968 * x * x * x - 2.1128 + 0.4;
+    }
+
+    template <typename T>
+    struct BasicTable {
+        T values[SIZE];
+
+        constexpr BasicTable() : values() {
+            for (std::size_t i = 0; i < SIZE; ++i) {
+                values[i] = static_cast<T>(polynomial(X_MIN + STEP * i));
+            }
+        }
+    };
+
+    constexpr BasicTable<double> TABLE{};
+    constexpr BasicTable<float> TABLE_F{}; // for the single-precision kernels
+
+    constexpr double clampRange(double v, double lo, double hi) {
+        return v < lo ? lo : (v > hi ? hi : v);
+    }
+
+    // Efficiency for a raw load factor; out-of-range inputs are clamped first
+    constexpr double lookup(double loadFactor) {
+        double x = clampRange(loadFactor, X_MIN, X_MAX);
+        double pos = (x - X_MIN) * INV_STEP;
+        std::size_t idx = static_cast<std::size_t>(pos);
+        if (idx > SIZE - 2) idx = SIZE - 2;
+        double frac = pos - static_cast<double>(idx);
+        double v = TABLE.values[idx] + frac * (TABLE.values[idx + 1] - TABLE.values[idx]);
+        return clampRange(v, EFF_MIN, EFF_MAX);
+    }
+
+    // Single-precision lookup on TABLE_F, same scheme as lookup()
+    constexpr float lookupF(float loadFactor) {
+        float x = loadFactor < float(X_MIN) ? float(X_MIN) : (loadFactor > float(X_MAX) ? float(X_MAX) : loadFactor);
+        float pos = (x - float(X_MIN)) * float(INV_STEP);
+        std::size_t idx = static_cast<std::size_t>(pos);
+        if (idx > SIZE - 2) idx = SIZE - 2;
+        float frac = pos - static_cast<float>(idx);
+        float v = TABLE_F.values[idx] + frac * (TABLE_F.values[idx + 1] - TABLE_F.values[idx]);
+        return v < float(EFF_MIN) ? float(EFF_MIN) : (v > float(EFF_MAX) ? float(EFF_MAX) : v);
+    }
+
+    constexpr double maxMidpointError() {
+        double worst = 0.0;
+        for (std::size_t i = 0; i + 1 < SIZE; ++i) {
+            double x = X_MIN + STEP * (i + 0.5);
+            double diff = lookup(x) - clampRange(polynomial(x), EFF_MIN, EFF_MAX);
+            if (diff < 0) diff = -diff;
+            if (diff > worst) worst = diff;
+        }
+        return worst;
+    }
+
+    static_assert(maxMidpointError() <= MAX_ABS_ERROR, "efficiency table exceeds documented error bound");
+}
+
+#endif
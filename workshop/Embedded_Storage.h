@@ -0,0 +1,107 @@
+#ifndef EMBEDDED_STORAGE_H
+#define EMBEDDED_STORAGE_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Storage.h"
+#include "Vehicle.h"
+
+// In-process storage for machines without a MySQL server.
+//
+// Every table is held in memory and lookups are plain map reads under a
+// shared lock. Each table is a tab-separated file in `directory`. Small
+// tables are rewritten whole (to a temporary file, then renamed over the
+// old one) on every change. Calculation history is appended to as records
+// arrive and rewritten only when records are deleted.
+//
+// environment_presets.tsv is read-only here: terrain, climate, gradient,
+// roughness, temperature, pressure per line, maintained by hand.
+class EmbeddedStorage : public Storage {
+public:
+    explicit EmbeddedStorage(const std::string& directory);
+
+    EmbeddedStorage(const EmbeddedStorage&) = delete;
+    EmbeddedStorage& operator=(const EmbeddedStorage&) = delete;
+
+    // Creates the directory if needed and loads every table
+    bool open();
+
+    const char* backendName() const override { return "embedded"; }
+
+    bool vehicleExists(const std::string& id) override;
+    bool loadVehicle(const std::string& id, Vehicle& out) override;
+    bool loadAllVehicles(std::vector<Vehicle>& out) override;
+    int insertVehicle(const Vehicle& vehicle) override;
+    int updateVehicle(const Vehicle& changes) override;
+    int deleteVehicle(const std::string& id) override;
+    int upsertVehicles(const std::vector<Vehicle>& vehicles) override;
+
+    bool savePreset(const MissionPreset& preset) override;
+    int loadPreset(const std::string& name, MissionPreset& out) override;
+    bool listPresets(std::vector<MissionPreset>& out) override;
+    int deletePreset(const std::string& name) override;
+
+    bool findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) override;
+    bool listEnvironments(std::vector<EnvironmentPreset>& out) override;
+
+    bool loadFuelPrice(double& price) override;
+    bool saveFuelPrice(double price) override;
+
+    bool findUser(const std::string& username, UserAccount& out) override;
+    std::vector<UserAccount> listUsers() override;
+    int countUsers() override;
+    int insertUser(const UserAccount& user) override;
+    int updatePasswordHash(const std::string& username, const std::string& passwordHash) override;
+    int updateRole(const std::string& username, const std::string& role) override;
+    int deleteUser(const std::string& username) override;
+
+    bool appendCalculations(const std::vector<CalculationRecord>& records) override;
+    std::vector<CalculationRecord> queryCalculations(const CalculationQuery& query) override;
+    bool getCalculation(int id, CalculationRecord& out) override;
+    int deleteCalculation(int id, const std::string& owner) override;
+    int deleteUserCalculations(const std::string& username) override;
+    CalculationTotals calculationTotals(const std::string& username) override;
+    std::vector<std::string> calculationUsers() override;
+    bool scanCalculations(const std::string& username,
+        const std::function<void(const CalculationRecord&)>& visit) override;
+
+    size_t maxConcurrency() const override;
+    void displayStats() const override;
+
+private:
+    std::string directory;
+
+    mutable std::shared_mutex lock;
+    std::map<std::string, Vehicle> vehicles;
+    std::map<std::string, MissionPreset> presets;
+    std::vector<EnvironmentPreset> environments;
+    std::map<std::string, UserAccount> users;
+    bool hasFuelPrice;
+    double fuelPrice;
+
+    // Ordered by (calculated_at, id); new records are stamped with the
+    // current time and the next id, so this is also id order
+    std::vector<CalculationRecord> history;
+    std::unordered_map<std::string, std::vector<uint32_t>> historyByUser; // positions in history
+    int nextCalculationId;
+    std::ofstream historyLog;
+
+    std::string pathOf(const char* table) const;
+    bool loadTables();
+    void indexHistory();
+
+    // Whole-table rewrites; the caller holds the exclusive lock
+    bool saveVehicles();
+    bool savePresets();
+    bool saveUsers();
+    bool writeFuelPrice();
+    bool saveHistory();
+    bool replaceFile(const char* table, const std::string& contents);
+};
+
+#endif
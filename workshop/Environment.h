@@ -2,7 +2,7 @@
 #include <cmath>
 #include <string>
 
-class DatabaseManager;
+class Storage;
 
 class Environment {
 public:
@@ -14,8 +14,9 @@ public:
     double roadGradient = 0.0;
     double surfaceRoughness = 0.012;
 
-    void loadEnvironment(const std::string& tType, const std::string& cType, DatabaseManager* db);
+    void loadEnvironment(const std::string& tType, const std::string& cType, Storage* storage);
 
     double getAirDensity() const;
+    static double airDensity(double tempC, double pressurePa);
     void setRawEnvironment(double grad, double rough, double temp);
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef HISTORY_WRITER_H
+#define HISTORY_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Storage.h"
+#include "Calculation_Record.h"
+
+// Write-behind stage for calculation_history.
+//
+// submit() stamps a record's calculated_at (unless already set), queues it
+// and returns immediately; a background thread collects queued records into
+// batches of up to batchSize rows, appended through the storage backend
+// whenever a full batch is waiting or flushInterval has passed since the
+// oldest unwritten record arrived.
+// The destructor drains the queue before returning.
+//
+// DURABLE drops no record the backend would take: submit() blocks while the
+// queue is full, and failed batches are retried until they succeed or the
+// writer shuts down. A batch refused twice is retried row by row, and rows the
+// backend refuses while it accepts others (a value too long for its column,
+// say) are dropped and reported instead of holding up the queue.
+// THROUGHPUT never blocks the caller: records arriving at a full queue and
+// batches the backend rejects are dropped and counted.
+class HistoryWriter {
+public:
+    enum class Mode { DURABLE, THROUGHPUT };
+
+    struct Options {
+        Mode mode = Mode::DURABLE;
+        size_t batchSize = 500;
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(200);
+        size_t queueCapacity = 100000;
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        uint64_t batches = 0;
+        uint64_t failedBatches = 0;
+        size_t queued = 0;
+    };
+
+    explicit HistoryWriter(Storage* storage);
+    HistoryWriter(Storage* storage, const Options& options);
+    ~HistoryWriter();
+
+    HistoryWriter(const HistoryWriter&) = delete;
+    HistoryWriter& operator=(const HistoryWriter&) = delete;
+
+    // False only in THROUGHPUT mode when the record was dropped
+    bool submit(CalculationRecord record);
+    bool submit(std::vector<CalculationRecord>&& records);
+
+    // Blocks until every record submitted before the call is written or
+    // dropped; false if the timeout expired first (e.g. backend unreachable)
+    bool flush(std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    Mode mode() const { return options.mode; }
+    Stats stats() const;
+    void displayStats() const;
+
+private:
+    Storage* storage;
+    Options options;
+
+    mutable std::mutex lock;
+    std::condition_variable workReady;   // writer: records or shutdown waiting
+    std::condition_variable spaceReady;  // DURABLE submitters: queue drained
+    std::condition_variable progress;    // flush(): records settled
+    std::deque<CalculationRecord> queue;
+    std::chrono::steady_clock::time_point oldestQueued;
+    uint64_t accepted;       // records that entered the queue
+    uint64_t settled;        // of those, written or dropped (in queue order)
+    uint64_t flushTarget;
+    bool stopping;
+    Stats counters;
+
+    std::thread writer;
+
+    void run();
+    bool writeBatch(const std::vector<CalculationRecord>& batch);
+
+    // Writes a refused batch one row at a time. Once a row goes in, the rows
+    // the backend refuses are dropped and reported; until then at most
+    // `probes` rows are tried. Rows neither written nor dropped stay in
+    // `batch`, in order.
+    void writeRows(std::vector<CalculationRecord>& batch, size_t probes, size_t& written, size_t& rejected);
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Vehicle.h"
+#include "Calculator.h"
+
+class ThreadPool;
+
+// xoshiro256** with jump(): each call to jump() advances 2^128 draws, so
+// stream k (k jumps from the seeded state) never overlaps any other stream.
+class RandomStream {
+public:
+    RandomStream(uint64_t seed, uint64_t streamIndex);
+
+    uint64_t next();
+    double uniform(); // [0, 1), 53-bit resolution
+
+private:
+    uint64_t s[4];
+    void jump();
+};
+
+// Input distribution. Sampling is implemented here rather than with
+// std::*_distribution so results do not depend on the standard library.
+struct Distribution {
+    enum class Kind { FIXED, UNIFORM, NORMAL, TRIANGULAR };
+
+    Kind kind = Kind::FIXED;
+    double a = 0.0; // FIXED: value, UNIFORM: min, NORMAL: mean, TRIANGULAR: min
+    double b = 0.0; // UNIFORM: max, NORMAL: std dev, TRIANGULAR: mode
+    double c = 0.0; // TRIANGULAR: max
+
+    static Distribution fixed(double value) { return { Kind::FIXED, value, 0.0, 0.0 }; }
+    static Distribution uniform(double min, double max) { return { Kind::UNIFORM, min, max, 0.0 }; }
+    static Distribution normal(double mean, double stddev) { return { Kind::NORMAL, mean, stddev, 0.0 }; }
+    static Distribution triangular(double min, double mode, double max) { return { Kind::TRIANGULAR, min, mode, max }; }
+
+    double sample(RandomStream& rng) const;
+    std::string describe() const;
+};
+
+struct MonteCarloSpec {
+    Distribution gradient = Distribution::fixed(0.0);
+    Distribution roughness = Distribution::fixed(1.0);
+    Distribution temperatureC = Distribution::fixed(15.0);
+    Distribution speedKmh = Distribution::fixed(60.0);
+
+    double distanceKm = 100.0;
+    size_t draws = 1000000;
+    uint64_t seed = 1;
+    size_t histogramBins = 20;
+};
+
+struct MonteCarloResult {
+    size_t draws = 0;
+    size_t streams = 0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p5 = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+
+    double histogramStart = 0.0;
+    double binWidth = 0.0;
+    std::vector<size_t> histogram;
+};
+
+// Samples mission inputs and reports the fuel (L) distribution.
+//
+// The draws are split statically into `streams` equal slices (default: one
+// per pool thread). Each slice owns its RandomStream, SoA buffers and output
+// range, so workers share nothing and take no locks. Because the slice
+// boundaries, stream seeds and reduction order depend only on (seed, streams),
+// results are bit-reproducible for a given seed and thread count regardless
+// of which worker runs which slice.
+class MonteCarloEngine {
+public:
+    MonteCarloEngine(ThreadPool& pool);
+
+    MonteCarloResult run(const Vehicle& vehicle, const MonteCarloSpec& spec, size_t streams = 0);
+
+    void displayResult(const MonteCarloResult& result) const;
+
+private:
+    ThreadPool& pool;
+    Calculator calculator;
+};
+
+#endif
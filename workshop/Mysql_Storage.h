@@ -0,0 +1,75 @@
+#ifndef MYSQL_STORAGE_H
+#define MYSQL_STORAGE_H
+
+#include "Storage.h"
+#include "Database_Manager.h"
+
+// Storage on a MySQL server through DatabaseManager.
+//
+// Calls use the calling thread's connection (DatabaseManager::getConnection),
+// except appendCalculations and scanCalculations, which run on the history
+// writer and export worker threads and so always take a pooled connection of
+// their own.
+class MySqlStorage : public Storage {
+public:
+    explicit MySqlStorage(DatabaseManager* db);
+
+    const char* backendName() const override { return "MySQL"; }
+
+    bool vehicleExists(const std::string& id) override;
+    bool loadVehicle(const std::string& id, Vehicle& out) override;
+    bool loadAllVehicles(std::vector<Vehicle>& out) override;
+    int insertVehicle(const Vehicle& vehicle) override;
+    int updateVehicle(const Vehicle& changes) override;
+    int deleteVehicle(const std::string& id) override;
+    int upsertVehicles(const std::vector<Vehicle>& vehicles) override;
+
+    bool savePreset(const MissionPreset& preset) override;
+    int loadPreset(const std::string& name, MissionPreset& out) override;
+    bool listPresets(std::vector<MissionPreset>& out) override;
+    int deletePreset(const std::string& name) override;
+
+    bool findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) override;
+    bool listEnvironments(std::vector<EnvironmentPreset>& out) override;
+
+    bool loadFuelPrice(double& price) override;
+    bool saveFuelPrice(double price) override;
+
+    bool findUser(const std::string& username, UserAccount& out) override;
+    std::vector<UserAccount> listUsers() override;
+    int countUsers() override;
+    int insertUser(const UserAccount& user) override;
+    int updatePasswordHash(const std::string& username, const std::string& passwordHash) override;
+    int updateRole(const std::string& username, const std::string& role) override;
+    int deleteUser(const std::string& username) override;
+
+    bool appendCalculations(const std::vector<CalculationRecord>& records) override;
+    std::vector<CalculationRecord> queryCalculations(const CalculationQuery& query) override;
+    bool getCalculation(int id, CalculationRecord& out) override;
+    int deleteCalculation(int id, const std::string& owner) override;
+    int deleteUserCalculations(const std::string& username) override;
+    CalculationTotals calculationTotals(const std::string& username) override;
+    std::vector<std::string> calculationUsers() override;
+    bool scanCalculations(const std::string& username,
+        const std::function<void(const CalculationRecord&)>& visit) override;
+
+    size_t maxConcurrency() const override { return db->poolCapacity(); }
+    void displayStats() const override {
+        db->displayPoolStats();
+        db->displayQueryStats();
+    }
+
+    DatabaseManager* database() const { return db; }
+
+private:
+    DatabaseManager* db;
+
+    // Runs a statement whose only result is the affected row count
+    int executeUpdate(const char* sql, MYSQL_BIND* params);
+    // One multi-row INSERT ... ON DUPLICATE KEY UPDATE for `count` vehicles
+    int upsertVehicleRows(const Vehicle* vehicles, size_t count);
+    // Drains an executed record query through bound result buffers
+    std::vector<CalculationRecord> fetchRecords(MYSQL_STMT* stmt);
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "Vehicle.h"
+#include "Calculator.h"
+
+class ThreadPool;
+
+// Evenly spaced values start, ..., stop (steps >= 1; steps == 1 gives start)
+struct SweepRange {
+    double start = 0.0;
+    double stop = 0.0;
+    size_t steps = 1;
+
+    double at(size_t i) const {
+        return steps > 1 ? start + (stop - start) * static_cast<double>(i) / static_cast<double>(steps - 1) : start;
+    }
+};
+
+// Axes of the grid, slowest-varying first. Speed is the innermost axis.
+enum SweepAxis {
+    AXIS_TIRE_PRESSURE = 0,
+    AXIS_TEMPERATURE,
+    AXIS_ROUGHNESS,
+    AXIS_GRADIENT,
+    AXIS_SPEED,
+    SWEEP_AXES
+};
+
+struct SweepSpec {
+    SweepRange axes[SWEEP_AXES];
+    double distanceKm = 100.0;
+    double pressurePa = 101325.0;
+    Calculator::Precision precision = Calculator::Precision::DOUBLE;
+
+    size_t pointCount() const;
+};
+
+// Dense row-major N-dimensional array of fuel results (L), indexed by SweepAxis order
+class SweepResult {
+public:
+    SweepSpec spec;
+    std::vector<double> liters;
+
+    size_t flatIndex(const size_t coords[SWEEP_AXES]) const;
+    void coordinates(size_t flat, size_t coords[SWEEP_AXES]) const;
+
+    // One row per grid point: axis values followed by liters
+    bool writeCSV(const std::string& filename) const;
+
+    // "FSWP" magic, uint32 version, uint32 axis count, per axis {double start,
+    // double stop, uint64 steps}, double distance_km, then liters in row-major order
+    bool writeBinary(const std::string& filename) const;
+};
+
+class ParameterSweep {
+public:
+    ParameterSweep(ThreadPool& pool);
+
+    // Evaluates every grid point for one vehicle; the vehicle's own tire
+    // pressure is replaced by the tire-pressure axis.
+    SweepResult run(const Vehicle& vehicle, const SweepSpec& spec);
+
+private:
+    ThreadPool& pool;
+    Calculator calculator;
+};
+
+#endif
@@ -2,11 +2,16 @@
 #define PRESET_H
 
 #include <string>
-#include "Database_Manager.h"
+#include "Storage.h"
+#include "Preset_Cache.h"
 
+class ResultCache;
+
+// Loads and listings are answered from a PresetCache once read; saves and
+// deletes invalidate it.
 class Preset {
 public:
-    Preset(DatabaseManager* db);
+    Preset(Storage* storage);
 
     void savePreset(const std::string& name, double gradient, double roughness, double temperature);
 
@@ -16,8 +21,15 @@ public:
 
     void listPresets();
 
+    // Cached mission results are dropped when a preset is saved or deleted
+    void setResultCache(ResultCache* cache) { resultCache = cache; }
+
+    void displayCacheStats() const { cache.displayStats(); }
+
 private:
-    DatabaseManager* db;
+    Storage* storage;
+    ResultCache* resultCache = nullptr;
+    PresetCache cache;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef PRESET_CACHE_H
+#define PRESET_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Storage.h"
+
+// Mission presets by name, in front of Storage::loadPreset / listPresets.
+//
+// Lookups are kept in a bounded LRU, misses included: a name the store does
+// not have is remembered as absent, so asking for it again costs no query.
+// Only answers the store actually gave are stored; a failed read is not.
+// Found presets are kept under the name the store returned, absent ones
+// under the name asked for. The full listing is kept beside it. Every
+// invalidation bumps the cache version, which retires the listing; results
+// are stored with the version taken before the store was read, and refused
+// if a write came in between. While the listing is current it also finds
+// presets the LRU does not hold, by exact name only.
+//
+// The store matches names regardless of case and accents, so a write under
+// one spelling can change what another finds: Preset invalidates the whole
+// cache on every save or delete. Changes made by other processes are seen
+// after clear(). All members are safe to call from several threads.
+class PresetCache {
+public:
+    enum class Lookup { MISS, FOUND, ABSENT };
+
+    explicit PresetCache(size_t capacity = 256);
+
+    // Taken before reading the store and handed back to the store* calls
+    uint64_t version() const;
+
+    // FOUND copies the preset into `out`; ABSENT means the store said it does
+    // not have it; MISS means the store has to be asked
+    Lookup find(const std::string& name, MissionPreset& out);
+    void storeFound(const MissionPreset& preset, uint64_t readAtVersion);
+    void storeAbsent(const std::string& name, uint64_t readAtVersion);
+
+    bool listing(std::vector<MissionPreset>& out);
+    void storeListing(std::vector<MissionPreset> list, uint64_t readAtVersion);
+
+    void invalidate();
+    void clear();
+
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+    size_t size() const;
+    size_t capacity() const { return maxEntries; }
+
+    void displayStats() const;
+
+private:
+    struct Entry {
+        MissionPreset preset;   // name only when absent
+        bool present;
+    };
+
+    using LruList = std::list<Entry>;
+
+    void store(const MissionPreset& preset, bool present, uint64_t readAtVersion);
+
+    size_t maxEntries;
+    mutable std::mutex lock;
+    LruList lru; // most recently used first
+    std::unordered_map<std::string, LruList::iterator> index;
+
+    uint64_t currentVersion = 1;
+    uint64_t listingVersion = 0;  // current while equal to currentVersion
+    std::vector<MissionPreset> presets;
+
+    std::atomic<uint64_t> hitCount{ 0 };
+    std::atomic<uint64_t> missCount{ 0 };
+    std::atomic<uint64_t> listingHits{ 0 };
+    std::atomic<uint64_t> listingReads{ 0 };
+};
+
+#endif
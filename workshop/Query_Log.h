@@ -0,0 +1,93 @@
+#ifndef QUERY_LOG_H
+#define QUERY_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-statement latency, row and round-trip counters for DatabaseManager.
+//
+// Statements are keyed by SQL text (or by a caller-supplied label for SQL
+// that embeds values). entry() finds or creates the counters once; record()
+// is then lock-free - a handful of relaxed atomic adds - so the timed
+// execution paths stay well under a microsecond of overhead per call.
+//
+// Latencies go into power-of-two microsecond buckets, from which the
+// summary estimates percentiles. Statements slower than the slow-query
+// threshold are also appended, one line each, to the slow-query log.
+class QueryLog {
+public:
+    static const int BUCKETS = 32;   // bucket i: [2^i, 2^(i+1)) us; bucket 0 also holds < 1 us
+
+    struct Entry {
+        explicit Entry(const std::string& sql) : sql(sql) {}
+
+        const std::string sql;
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> errors{ 0 };
+        std::atomic<uint64_t> rows{ 0 };
+        std::atomic<uint64_t> roundTrips{ 0 };
+        std::atomic<uint64_t> totalNs{ 0 };
+        std::atomic<uint64_t> maxNs{ 0 };
+        std::atomic<uint64_t> buckets[BUCKETS] = {};
+    };
+
+    struct Summary {
+        std::string sql;
+        uint64_t calls = 0;
+        uint64_t errors = 0;
+        uint64_t rows = 0;
+        uint64_t roundTrips = 0;
+        double totalMs = 0.0;
+        double meanMs = 0.0;
+        double p50Ms = 0.0;     // upper edge of the bucket holding the percentile
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    QueryLog();
+
+    QueryLog(const QueryLog&) = delete;
+    QueryLog& operator=(const QueryLog&) = delete;
+
+    // Counters for a statement; the pointer stays valid for the log's lifetime
+    Entry* entry(const std::string& sql);
+
+    // One execution: its latency, result rows (or affected rows) and round trips
+    void record(Entry* entry, std::chrono::nanoseconds elapsed, uint64_t rows, uint32_t roundTrips, bool ok);
+
+    // Rows counted after the timed call, e.g. fetched from an unbuffered result
+    void addRows(Entry* entry, uint64_t rows);
+    void addRoundTrips(Entry* entry, uint32_t roundTrips);
+
+    // An empty path or zero threshold turns the slow-query log off
+    void setSlowQueryLog(const std::string& path, std::chrono::milliseconds threshold);
+    bool isSlow(std::chrono::nanoseconds elapsed) const {
+        int64_t threshold = slowThresholdNs.load(std::memory_order_relaxed);
+        return threshold > 0 && elapsed.count() >= threshold;
+    }
+    void logSlow(const Entry* entry, std::chrono::nanoseconds elapsed, uint64_t rows);
+
+    // Sorted by total time, slowest first
+    std::vector<Summary> summaries() const;
+    void display(size_t top = 15) const;
+
+private:
+    mutable std::mutex lock;
+    std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+
+    std::atomic<int64_t> slowThresholdNs;
+    mutable std::mutex slowLock;
+    std::ofstream slowLog;
+    std::string slowLogPath;
+};
+
+#endif
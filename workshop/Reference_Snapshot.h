@@ -0,0 +1,98 @@
+#ifndef REFERENCE_SNAPSHOT_H
+#define REFERENCE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Storage.h"
+#include "Vehicle.h"
+
+class Environment;
+
+// Everything a calculation needs besides its own inputs
+struct ReferenceData {
+    std::vector<Vehicle> vehicles;
+    std::vector<MissionPreset> presets;
+    std::vector<EnvironmentPreset> environments;
+    bool hasFuelPrice = false;
+    double fuelPrice = 0.0;
+};
+
+// Read-only view of a reference data file, memory-mapped.
+//
+// The file is laid out to be used in place: a fixed header, then arrays of
+// fixed-size records (vehicles sorted by id, presets sorted by name,
+// environments in table order) whose text fields point into one string
+// pool. Opening maps the file and checks the header, the section bounds and
+// a checksum of everything after the header; lookups then read the mapped
+// records directly - vehicles and presets by binary search - with nothing
+// parsed or copied up front.
+//
+// Files are written in the machine's byte order, which the header records;
+// a file from a machine of the other order is rejected rather than
+// converted. formatVersion changes whenever the layout does. `generation`
+// is chosen by the writer and grows each time the data is regenerated.
+//
+// An open snapshot is immutable and may be read from any number of threads.
+class ReferenceSnapshot {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+
+    ReferenceSnapshot();
+    ~ReferenceSnapshot();
+
+    ReferenceSnapshot(const ReferenceSnapshot&) = delete;
+    ReferenceSnapshot& operator=(const ReferenceSnapshot&) = delete;
+
+    // Reads the reference tables from `storage`
+    static bool collect(Storage* storage, ReferenceData& out);
+
+    // Writes `data` to `path` (through a temporary file renamed into place)
+    static bool write(const std::string& path, const ReferenceData& data, uint64_t generation);
+
+    // Maps and validates `path`; false (after reporting why) if it is missing,
+    // damaged or of another format version
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    uint64_t generation() const;
+    int64_t createdAt() const;    // seconds since the epoch
+    size_t fileSize() const { return size; }
+
+    size_t vehicleCount() const;
+    bool findVehicle(const std::string& id, Vehicle& out) const;   // attributes only, as Storage::loadVehicle
+    std::vector<Vehicle> vehicles(Storage* owner) const;
+
+    size_t presetCount() const;
+    bool findPreset(const std::string& name, MissionPreset& out) const;
+    std::vector<MissionPreset> presets() const;
+
+    // First environment matching either the terrain or the climate
+    bool findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) const;
+    std::vector<EnvironmentPreset> environments() const;
+
+    bool fuelPrice(double& price) const;
+
+private:
+    struct Header;
+    struct Text;
+    struct VehicleRecord;
+    struct PresetRecord;
+    struct EnvironmentRecord;
+
+    const char* base;   // start of the mapped view, nullptr when closed
+    size_t size;
+
+    const Header& header() const;
+    const VehicleRecord* vehicleRecords() const;
+    const PresetRecord* presetRecords() const;
+    const EnvironmentRecord* environmentRecords() const;
+    std::string_view text(const Text& t) const;
+    bool validate(const std::string& path) const;
+    void fillVehicle(const VehicleRecord& record, Vehicle& out) const;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Vehicle.h"
+
+// Memoized mission results, keyed on the vehicle, the preset (if any) and the
+// quantized mission inputs.
+//
+// An entry holds everything a rerun needs - the vehicle record, the
+// environment and the fuel figure - so a hit skips Vehicle::loadVehicle,
+// Preset::loadPreset and Calculator::calculate altogether. Inputs closer
+// together than the quanta below share an entry.
+//
+// Bounded LRU; all members are safe to call from several threads. Vehicle and
+// Preset call invalidateVehicle / invalidatePreset whenever they change the
+// underlying rows.
+class ResultCache {
+public:
+    // Quantization steps of the key
+    static constexpr double GRADIENT_STEP = 1e-4;
+    static constexpr double ROUGHNESS_STEP = 1e-4;
+    static constexpr double TEMPERATURE_STEP = 0.01; // Celsius
+    static constexpr double DISTANCE_STEP = 0.001;   // km
+    static constexpr double SPEED_STEP = 0.01;       // km/h
+
+    struct Key {
+        std::string vehicleId;
+        std::string presetName;   // empty for manually entered environments
+        int64_t quantized[5] = {}; // gradient, roughness, temperature, distance, speed
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct Entry {
+        Vehicle vehicle{ nullptr };
+        double roadGradient = 0.0;
+        double surfaceRoughness = 0.0;
+        double ambientTempC = 0.0;
+        double liters = 0.0;
+    };
+
+    explicit ResultCache(size_t capacity = 4096);
+
+    // Key for a mission with an explicitly entered environment
+    static Key manualKey(const std::string& vehicleId, double gradient, double roughness,
+        double temperatureC, double distanceKm, double speedKmh);
+
+    // Key for a mission run from a saved preset; the environment comes from the entry
+    static Key presetKey(const std::string& vehicleId, const std::string& presetName,
+        double distanceKm, double speedKmh);
+
+    // Copies the entry out and counts a hit, or counts a miss and returns false
+    bool find(const Key& key, Entry& out);
+    void store(const Key& key, const Entry& entry);
+
+    void invalidateVehicle(const std::string& vehicleId);
+    void invalidatePreset(const std::string& presetName);
+    void clear();
+
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+    size_t size() const;
+    size_t capacity() const { return maxEntries; }
+
+    void displayStats() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    using LruList = std::list<std::pair<Key, Entry>>;
+
+    template <typename Pred>
+    void eraseIf(Pred pred);
+
+    size_t maxEntries;
+    mutable std::mutex lock;
+    LruList lru; // most recently used first
+    std::unordered_map<Key, LruList::iterator, KeyHash> index;
+
+    std::atomic<uint64_t> hitCount{ 0 };
+    std::atomic<uint64_t> missCount{ 0 };
+};
+
+#endif
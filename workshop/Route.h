@@ -0,0 +1,37 @@
+#ifndef ROUTE_H
+#define ROUTE_H
+
+#include <string>
+#include <vector>
+
+// One homogeneous stretch of a route.
+struct RouteSegment {
+    double lengthKm;
+    double gradient;      // rise / run, e.g. 0.05 for 5%
+    double roughness;
+    double temperatureC;
+    double speedKmh;
+};
+
+class Route {
+public:
+    std::vector<RouteSegment> segments;
+
+    // Reads a CSV route file, one segment per line:
+    //   length_km,gradient,roughness,temperature_c,speed_kmh
+    // Blank lines, lines starting with '#' and a non-numeric header are skipped.
+    bool loadFromFile(const std::string& filename);
+
+    void addSegment(double lengthKm, double gradient, double roughness, double temperatureC, double speedKmh);
+    void clear() { segments.clear(); }
+
+    double totalDistanceKm() const;
+    double totalDurationHours() const;
+
+    // Distance-weighted means, used when a route mission is logged to history
+    double averageGradient() const;
+    double averageRoughness() const;
+    double averageTemperatureC() const;
+};
+
+#endif
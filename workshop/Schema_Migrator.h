@@ -0,0 +1,51 @@
+#ifndef SCHEMA_MIGRATOR_H
+#define SCHEMA_MIGRATOR_H
+
+#include <string>
+#include <vector>
+#include "Database_Manager.h"
+
+// Creates and upgrades the MySQL schema the application expects.
+//
+// Migrations are numbered and applied in order; schema_version records the
+// ones already applied, so each runs once per database. Every step checks
+// information_schema first, which lets a database whose tables were created
+// by hand adopt the migrations without errors: existing tables, columns and
+// indexes (matched by name or by column list) are left alone.
+//
+// verifyIndexes() EXPLAINs the selective queries MySqlStorage issues and
+// reports any that the server would answer with a full table scan.
+class SchemaMigrator {
+public:
+    struct QueryPlan {
+        std::string label;
+        std::string table;
+        std::string accessType;     // EXPLAIN "type": const, ref, range, index, ALL...
+        std::string key;            // chosen index, empty if none
+        std::string possibleKeys;
+    };
+
+    explicit SchemaMigrator(DatabaseManager* db);
+
+    // Applies pending migrations; false (after reporting) if one failed
+    bool migrate();
+
+    // Highest applied migration, 0 for an empty database, -1 on error
+    int currentVersion();
+    static int latestVersion();
+
+    // True if no checked query plans a full scan; plans are printed when
+    // `verbose` is set, otherwise only the offending ones
+    bool verifyIndexes(bool verbose = false);
+    std::vector<QueryPlan> explainQueries();
+
+private:
+    DatabaseManager* db;
+
+    bool execute(const std::string& sql);
+    bool queryInt(const std::string& sql, long long& value);
+    bool columnExists(const char* table, const char* column);
+    bool indexExists(const char* table, const char* name, const char* columns);
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef SNAPSHOT_STORAGE_H
+#define SNAPSHOT_STORAGE_H
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "Storage.h"
+#include "Reference_Snapshot.h"
+
+// Serves reference data - vehicles, mission presets, environment presets and
+// the fuel price - from a memory-mapped ReferenceSnapshot file instead of the
+// database.
+//
+// Over a backing store (MySQL or embedded), everything else is passed
+// through, and every successful change to reference data made through this
+// object regenerates the file, so the next process to start maps current
+// data. Bulk imports only mark the file stale; it is rebuilt once, before
+// the next reference read or when the object is destroyed. If a rebuild
+// fails, reference reads go to the backing store until a later write,
+// regenerate() or the destructor rebuilds the file. Changes made to the
+// tables by other means are picked up by regenerate() or by opening with
+// `refresh`.
+//
+// Without a backing store only the reference reads work: a calculation-only
+// process maps the file and runs with no database connection at all. Other
+// calls report that they need a database and fail.
+class SnapshotStorage : public Storage {
+public:
+    SnapshotStorage(const std::string& path, Storage* backing);
+    ~SnapshotStorage();
+
+    SnapshotStorage(const SnapshotStorage&) = delete;
+    SnapshotStorage& operator=(const SnapshotStorage&) = delete;
+
+    // Maps the file. With a backing store the file is first (re)built from
+    // it if it is missing, unusable or `refresh` is set.
+    bool open(bool refresh = false);
+
+    // Rebuilds the file from the backing store and maps the new one
+    bool regenerate();
+
+    const char* backendName() const override { return "snapshot"; }
+
+    bool vehicleExists(const std::string& id) override;
+    bool loadVehicle(const std::string& id, Vehicle& out) override;
+    bool loadAllVehicles(std::vector<Vehicle>& out) override;
+    int insertVehicle(const Vehicle& vehicle) override;
+    int updateVehicle(const Vehicle& changes) override;
+    int deleteVehicle(const std::string& id) override;
+    int upsertVehicles(const std::vector<Vehicle>& vehicles) override;
+
+    bool savePreset(const MissionPreset& preset) override;
+    int loadPreset(const std::string& name, MissionPreset& out) override;
+    bool listPresets(std::vector<MissionPreset>& out) override;
+    int deletePreset(const std::string& name) override;
+
+    bool findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) override;
+    bool listEnvironments(std::vector<EnvironmentPreset>& out) override;
+
+    bool loadFuelPrice(double& price) override;
+    bool saveFuelPrice(double price) override;
+
+    bool findUser(const std::string& username, UserAccount& out) override;
+    std::vector<UserAccount> listUsers() override;
+    int countUsers() override;
+    int insertUser(const UserAccount& user) override;
+    int updatePasswordHash(const std::string& username, const std::string& passwordHash) override;
+    int updateRole(const std::string& username, const std::string& role) override;
+    int deleteUser(const std::string& username) override;
+
+    bool appendCalculations(const std::vector<CalculationRecord>& records) override;
+    std::vector<CalculationRecord> queryCalculations(const CalculationQuery& query) override;
+    bool getCalculation(int id, CalculationRecord& out) override;
+    int deleteCalculation(int id, const std::string& owner) override;
+    int deleteUserCalculations(const std::string& username) override;
+    CalculationTotals calculationTotals(const std::string& username) override;
+    std::vector<std::string> calculationUsers() override;
+    bool scanCalculations(const std::string& username,
+        const std::function<void(const CalculationRecord&)>& visit) override;
+
+    size_t maxConcurrency() const override;
+    void displayStats() const override;
+
+private:
+    std::string path;
+    Storage* backing;
+
+    mutable std::shared_mutex lock;     // exclusive only while the file is swapped
+    ReferenceSnapshot snapshot;
+    std::mutex regenerateLock;
+    uint64_t generation = 0;            // of the last file mapped, set under `lock`
+    std::atomic<bool> stale;
+    std::atomic<bool> failed;           // the last rebuild did not map a new file
+
+    // Rebuilds a file left stale by a bulk write before it is read
+    void refreshIfStale();
+
+    // False, after saying so, when there is no backing store for `what`
+    bool needsBacking(const char* what) const;
+    // Regenerates after a write that changed `rows` reference rows
+    int changed(int rows);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SPEED_OPTIMIZER_H
+#define SPEED_OPTIMIZER_H
+
+#include <string>
+#include <vector>
+#include "Vehicle.h"
+#include "Environment.h"
+#include "Calculator.h"
+
+class ThreadPool;
+
+struct FuelCurvePoint {
+    double speedKmh;
+    double litersPerKm;
+};
+
+struct CruiseSpeedResult {
+    std::string vehicle_id;
+    double speedKmh = 0.0;
+    double litersPerKm = 0.0;
+    int evaluations = 0;
+    std::vector<FuelCurvePoint> curve; // samples around the optimum, ascending speed
+};
+
+// Finds the cruise speed that minimizes liters per km under Calculator's model.
+//
+// A coarse bracket over [minSpeedKmh, maxSpeedKmh] guards against the flat
+// stretches the efficiency clamp produces; golden-section search then narrows
+// the bracket to TOLERANCE_KMH in about 32 model evaluations per solve.
+class SpeedOptimizer {
+public:
+    static constexpr double TOLERANCE_KMH = 0.01;
+
+    SpeedOptimizer(double minSpeedKmh = 5.0, double maxSpeedKmh = 150.0);
+
+    CruiseSpeedResult solve(const Vehicle& vehicle, const Environment& environment,
+        double curveHalfWidthKmh = 20.0, int curvePoints = 9) const;
+
+    // Solves every vehicle in parallel; results keep the input order
+    std::vector<CruiseSpeedResult> solveFleet(const std::vector<Vehicle>& vehicles,
+        const Environment& environment, ThreadPool& pool) const;
+
+    void displayResult(const CruiseSpeedResult& result) const;
+
+private:
+    double minSpeed;
+    double maxSpeed;
+    Calculator calculator;
+
+    double litersPerKm(const Vehicle& vehicle, const Environment& environment, double speedKmh) const;
+};
+
+#endif
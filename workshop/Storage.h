@@ -0,0 +1,145 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Calculation_Record.h"
+
+class Vehicle;
+class Environment;
+
+struct MissionPreset {
+    std::string name;
+    double roadGradient = 0.0;
+    double surfaceRoughness = 0.0;
+    double ambientTempC = 0.0;
+};
+
+// One row of environment_presets
+struct EnvironmentPreset {
+    std::string terrain;
+    std::string climate;
+    double gradient = 0.0;
+    double roughness = 0.0;
+    double temperature = 0.0;
+    double pressure = 0.0;
+};
+
+struct UserAccount {
+    std::string username;
+    std::string passwordHash;   // "salt:hash"
+    std::string role;           // "admin" or "user"
+};
+
+// Selection for calculation history listings, newest first
+// (calculated_at DESC, id DESC). Empty strings match everything.
+struct CalculationQuery {
+    std::string username;
+    std::string vehicleId;
+    std::string fromDate;       // calculated_at >= fromDate
+    std::string toDate;         // calculated_at <= toDate
+    int limit = 100;
+
+    // Keyset cursor: only rows strictly after (cursorTime, cursorId) in the
+    // listing order, or strictly before it when `newer` is set (those come
+    // back oldest first)
+    bool hasCursor = false;
+    bool newer = false;
+    std::string cursorTime;
+    int cursorId = 0;
+};
+
+struct CalculationTotals {
+    int count = 0;
+    double totalFuel = 0.0;
+    double averageFuel = 0.0;
+};
+
+// Where the application's data lives.
+//
+// Vehicle, Preset, Environment, Cost, Auth and CalculationHistory keep their
+// validation and console output and go through this interface for reads and
+// writes, so the same menus run against a MySQL server (MySqlStorage) or an
+// in-process store on local disk (EmbeddedStorage).
+//
+// Failures are reported on std::cerr by the backend. Counts of affected rows
+// are returned as int, -1 meaning the operation itself failed. Updates count
+// the rows they matched, whether or not a value changed, and inserts return
+// 0 when the key is already taken, so a write reports "no such row" or
+// "already exists" itself and callers need no lookup beforehand.
+// Implementations must be safe to call from several threads at once.
+class Storage {
+public:
+    virtual ~Storage() = default;
+
+    virtual const char* backendName() const = 0;
+
+    // The list calls below fill `out` and return false, with `out` empty, if
+    // the backend could not be read.
+
+    // Vehicles. loadVehicle fills the attributes of `out` and returns false
+    // if there is no such vehicle. updateVehicle keeps the stored value of
+    // any attribute given as an empty model name or a non-positive number.
+    // upsertVehicles inserts or replaces every vehicle given, all or none,
+    // and returns how many it wrote.
+    virtual bool vehicleExists(const std::string& id) = 0;
+    virtual bool loadVehicle(const std::string& id, Vehicle& out) = 0;
+    virtual bool loadAllVehicles(std::vector<Vehicle>& out) = 0;   // ordered by id
+    virtual int insertVehicle(const Vehicle& vehicle) = 0;
+    virtual int updateVehicle(const Vehicle& changes) = 0;
+    virtual int deleteVehicle(const std::string& id) = 0;
+    virtual int upsertVehicles(const std::vector<Vehicle>& vehicles) = 0;
+
+    // Mission presets; savePreset replaces any preset of the same name.
+    // loadPreset returns 1 when found, 0 when there is no such preset and
+    // -1 when the backend could not be read; `out.name` is the name as
+    // stored, which may differ from the one asked for where the backend
+    // matches names by collation.
+    virtual bool savePreset(const MissionPreset& preset) = 0;
+    virtual int loadPreset(const std::string& name, MissionPreset& out) = 0;
+    virtual bool listPresets(std::vector<MissionPreset>& out) = 0;
+    virtual int deletePreset(const std::string& name) = 0;
+
+    // Environment presets matching either the terrain or the climate;
+    // fills gradient, roughness, temperature and pressure
+    virtual bool findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) = 0;
+    virtual bool listEnvironments(std::vector<EnvironmentPreset>& out) = 0;   // in insertion order
+
+    // Latest fuel price; false if none has been stored
+    virtual bool loadFuelPrice(double& price) = 0;
+    virtual bool saveFuelPrice(double price) = 0;
+
+    // Users
+    virtual bool findUser(const std::string& username, UserAccount& out) = 0;
+    virtual std::vector<UserAccount> listUsers() = 0;      // ordered by username
+    virtual int countUsers() = 0;
+    virtual int insertUser(const UserAccount& user) = 0;
+    virtual int updatePasswordHash(const std::string& username, const std::string& passwordHash) = 0;
+    virtual int updateRole(const std::string& username, const std::string& role) = 0;
+    virtual int deleteUser(const std::string& username) = 0;
+
+    // Calculation history. Records are stamped with an id on insert, and with
+    // the current time unless calculated_at is already set; the ones passed
+    // in are not modified.
+    virtual bool appendCalculations(const std::vector<CalculationRecord>& records) = 0;
+    virtual std::vector<CalculationRecord> queryCalculations(const CalculationQuery& query) = 0;
+    virtual bool getCalculation(int id, CalculationRecord& out) = 0;
+    virtual int deleteCalculation(int id, const std::string& owner) = 0; // owner "" for any user
+    virtual int deleteUserCalculations(const std::string& username) = 0;
+    virtual CalculationTotals calculationTotals(const std::string& username) = 0; // "" for all users
+    virtual std::vector<std::string> calculationUsers() = 0;
+
+    // Visits every record of one user ("" for all) in id order without
+    // holding the whole history in memory. The record passed to `visit` is
+    // reused between calls. False if the scan failed part way.
+    virtual bool scanCalculations(const std::string& username,
+        const std::function<void(const CalculationRecord&)>& visit) = 0;
+
+    // How many scans may usefully run at once
+    virtual size_t maxConcurrency() const = 0;
+    virtual void displayStats() const = 0;
+};
+
+#endif
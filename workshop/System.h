@@ -1,17 +1,23 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
-#include "Database_Manager.h"
+#include "Storage.h"
 #include "Preset.h"
 #include "Vehicle.h"
 #include "Environment.h"
 #include "Calculator.h"
+#include "Route.h"
+#include "Thread_Pool.h"
+#include "Result_Cache.h"
+#include "Vehicle_Catalog.h"
 #include "Auth.h"
 #include "Calculation_History.h"
+#include "History_Writer.h"
 
 class System {
 public:
-    System(DatabaseManager* db);
+    // History is written through a HistoryWriter in `historyMode`
+    System(Storage* storage, HistoryWriter::Mode historyMode = HistoryWriter::Mode::DURABLE);
 
     void runApplication();
 
@@ -23,12 +29,16 @@ public:
     void saveCalculationToHistory(const std::string& mission_name, double distance, double speed, double fuel_consumed);
 
 private:
-    DatabaseManager* db;
+    Storage* storage;
     Preset preset;
     Vehicle vehicle;
     Environment environment;
     Calculator calculator;
     CalculationHistory calcHistory;
+    HistoryWriter historyWriter;
+    ThreadPool workers;
+    ResultCache resultCache;
+    VehicleCatalog vehicleCatalog;
 
     // Current user info
     std::string currentUser;
@@ -45,6 +55,11 @@ private:
 
     // Mission functions
     void runManualMission();
+    void runRouteMission(const std::string& mission_name);
+    void runDriveCycleMission();
+    void runParameterSweep();
+    void runOptimalSpeed();
+    void runMonteCarlo();
     void loadMissionPreset();
     void saveMissionPreset();
     void deleteMissionPreset();
@@ -54,6 +69,7 @@ private:
     void addNewVehicle();
     void updateVehicleDetails();
     void deleteVehicle();
+    void importVehicles();
 
     // Calculation History helper functions
     void displayUserCalculations();
@@ -61,7 +77,10 @@ private:
     void displayCalculationStatistics();
     void deleteCalculationHistoryMenu();
     void displayAllUserCalculations();
+    // Offers next/previous for a history page; false to stop browsing
+    bool choosePage(const CalculationPage& page, std::string& token);
     void exportCalculationHistory();
+    void exportAllUsersHistory();
 
     void manageFuelPrice();
     void updateFuelPrice();
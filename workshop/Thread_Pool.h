@@ -0,0 +1,68 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size work-stealing thread pool.
+//
+// parallelFor() cuts [0, count) into chunks of `grain` and deals them out in
+// contiguous blocks, one block per worker deque. Each worker drains its own
+// deque from the back and, once empty, steals from the front of the others,
+// so uneven chunks (e.g. grid regions that hit the efficiency clamp) balance
+// themselves without a shared queue.
+class ThreadPool {
+public:
+    // body(begin, end, worker): worker is in [0, size()) and stable per thread
+    using RangeFn = std::function<void(size_t, size_t, size_t)>;
+
+    explicit ThreadPool(size_t threads = 0); // 0 = hardware concurrency
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Blocks until every chunk has run. Rethrows the first exception thrown by body.
+    void parallelFor(size_t count, size_t grain, const RangeFn& body);
+
+private:
+    struct Task {
+        size_t begin;
+        size_t end;
+    };
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    std::mutex stateLock;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    size_t generation = 0;
+    bool stopping = false;
+
+    std::mutex submitLock; // one parallelFor at a time
+    const RangeFn* currentBody = nullptr;
+    std::atomic<size_t> remaining{ 0 };
+    std::exception_ptr firstError;
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, Task& out);
+    void runTask(const Task& task, size_t index);
+};
+
+#endif
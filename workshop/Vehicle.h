@@ -1,8 +1,31 @@
 #pragma once
 #include <string>
-#include <mysql.h>
+#include <vector>
 
-class DatabaseManager;
+class Storage;
+class ResultCache;
+class VehicleCatalog;
+
+// The terms of the fuel model that depend only on the vehicle, derived once
+// rather than on every calculation. The attributes they were derived from are
+// kept alongside, so a copy whose attributes were assigned afterwards can be
+// told apart (see Vehicle::currentCoefficients).
+struct VehicleCoefficients {
+    double weightN = 0.0;       // m * g
+    double rollFactor = 0.0;    // m * g * tirePressureBar^-0.477; times roughness, the flat-road rolling force
+    double aeroFactor = 0.0;    // 0.5 * Cd * A; times rho * v^2, the drag force
+    double ratedPowerW = 0.0;
+
+    // Source attributes
+    double massKg = 0.0;
+    double dragCoef = 0.0;
+    double frontalArea = 0.0;
+    double tirePressureBar = 0.0;
+    double engineRatedPower = 0.0;
+
+    VehicleCoefficients() = default;
+    VehicleCoefficients(double massKg, double dragCoef, double frontalArea, double tirePressureBar, double engineRatedPower);
+};
 
 class Vehicle {
 public:
@@ -17,14 +40,17 @@ public:
     double efficiency;
     bool hasAC;
 
-    DatabaseManager* db;
+    Storage* storage;
+    ResultCache* resultCache = nullptr; // invalidated on update/delete, optional
+    VehicleCatalog* catalog = nullptr;  // lookups and writes go through it when set
+    VehicleCoefficients coefficients;   // refreshed by the constructors, setters, loads and updates
 
-    Vehicle(DatabaseManager* db);
+    Vehicle(Storage* storage);
     Vehicle(std::string id, double mass, double cd, double area, double power);
 
     ~Vehicle();
 
-    // Database Operations
+    // Storage Operations
     bool addVehicle(const std::string& id, const std::string& model, double efficiency,double mass, double cd, double area, double power, double tirePressure = 2.4, bool ac = false);
     bool updateVehicle(const std::string& id, const std::string& model, double efficiency, double mass, double cd, double area, double power, double tirePressure, bool ac);
 
@@ -32,15 +58,29 @@ public:
 
     void listVehicles();
     bool loadVehicle(const std::string& id);
+    static std::vector<Vehicle> loadAllVehicles(Storage* storage);
 
     // Utility Methods
     bool vehicleExists(const std::string& id);
     void displayVehicleDetails() const;
 
+    // Rederives `coefficients`; call after assigning the physical attributes
+    // directly
+    void refreshCoefficients();
+    // `coefficients` if they match the attributes, otherwise freshly derived
+    // ones (without storing them, so a shared const Vehicle stays race-free)
+    VehicleCoefficients currentCoefficients() const;
+
     // Setters
-    void setTirePressure(double pressure) { tirePressureBar = pressure; }
+    void setTirePressure(double pressure) { tirePressureBar = pressure; refreshCoefficients(); }
     void setHasAC(bool acStatus) { hasAC = acStatus; }
     void setEfficiency(double newEfficiency) { efficiency = newEfficiency; }
+    void setResultCache(ResultCache* cache) { resultCache = cache; }
+    void setCatalog(VehicleCatalog* vehicleCatalog) { catalog = vehicleCatalog; }
+
+    // Takes the attributes of `changes` that are set - a non-empty model
+    // name, positive numbers, and hasAC always - as Storage::updateVehicle does
+    void applyChanges(const Vehicle& changes);
 
     //debug
     //void debugCheckVehicle(const std::string& id);
@@ -0,0 +1,109 @@
+#ifndef VEHICLE_CATALOG_H
+#define VEHICLE_CATALOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Vehicle.h"
+
+class Storage;
+
+// In-memory copy of the vehicles table for lookups by vehicle_id.
+//
+// load() reads the table once into an immutable snapshot: the records in one
+// contiguous array, ordered by id, plus an open-addressing (linear probing)
+// hash index over their ids. Readers never take a lock - they pin the current
+// snapshot with a few atomic increments, probe it and copy the record out -
+// so any number of threads can look vehicles up concurrently.
+//
+// add/update/remove write through to the storage backend first and, once it
+// has accepted the change, build the next snapshot and publish it with a
+// single pointer swap. Writers are serialized; a reader sees either the old
+// snapshot or the new one, never a half-built index. Each snapshot counts
+// the readers pinning it, and every write frees the retired snapshots no
+// reader pins any more (the destructor frees the rest), so a steady stream
+// of readers does not keep old snapshots alive.
+//
+// Changes made to the table by other processes are not seen until the next
+// load().
+class VehicleCatalog {
+public:
+    explicit VehicleCatalog(Storage* storage);
+
+    VehicleCatalog(const VehicleCatalog&) = delete;
+    VehicleCatalog& operator=(const VehicleCatalog&) = delete;
+
+    // Replaces the contents with the whole vehicles table; false, keeping
+    // the contents, if storage could not be read
+    bool load();
+
+    // Replaces the contents without touching storage, e.g. from a snapshot file
+    void reset(std::vector<Vehicle> vehicles);
+
+    // Copies the stored attributes and their precomputed coefficients into
+    // `out`, leaving its storage, result cache and catalog pointers alone;
+    // false if there is no such vehicle
+    bool find(const std::string& id, Vehicle& out) const;
+    bool contains(const std::string& id) const;
+
+    std::vector<Vehicle> all() const;   // ordered by id
+    size_t size() const;
+
+    // Bumped by every published snapshot
+    uint64_t version() const;
+
+    // Write-through; same return values as the matching Storage calls
+    int add(const Vehicle& vehicle);
+    int update(const Vehicle& changes);
+    int remove(const std::string& id);
+
+    // Storage::upsertVehicles, published as one snapshot for the whole batch
+    int upsert(const std::vector<Vehicle>& vehicles);
+
+private:
+    struct Snapshot {
+        std::vector<Vehicle> records;   // ordered by vehicle_id
+        std::vector<uint64_t> hashes;   // hash of records[i].vehicle_id
+        std::vector<int32_t> slots;     // record index, -1 for empty; size is a power of two
+        uint64_t version = 0;
+        mutable std::atomic<int> pins{ 0 };
+
+        // Index of the record with this id, -1 if absent
+        int32_t indexOf(const std::string& id, uint64_t hash) const;
+    };
+
+    // Keeps the snapshot it pinned alive until it goes out of scope
+    class Pin {
+    public:
+        explicit Pin(const VehicleCatalog& catalog);
+        ~Pin();
+        const Snapshot* operator->() const { return snapshot; }
+        const Snapshot& operator*() const { return *snapshot; }
+
+    private:
+        const VehicleCatalog& catalog;
+        const Snapshot* snapshot;
+    };
+
+    static uint64_t hashId(const std::string& id);
+    static std::unique_ptr<Snapshot> build(std::vector<Vehicle> records, uint64_t version);
+
+    // Caller holds writeLock
+    void publish(std::vector<Vehicle> records);
+    void reclaim();
+
+    Storage* storage;
+
+    std::atomic<const Snapshot*> current;
+    mutable std::atomic<int> readers;   // between reading `current` and pinning it
+
+    std::mutex writeLock;
+    std::unique_ptr<const Snapshot> live;                   // owns `current`
+    std::vector<std::unique_ptr<const Snapshot>> retired;   // may still be pinned
+};
+
+#endif
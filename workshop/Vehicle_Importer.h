@@ -0,0 +1,67 @@
+#ifndef VEHICLE_IMPORTER_H
+#define VEHICLE_IMPORTER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Storage.h"
+#include "Vehicle.h"
+#include "Vehicle_Catalog.h"
+
+// Bulk load of vehicle specs from a CSV file.
+//
+// The first line names the columns, in any order, using the vehicles table's
+// column names:
+//
+//   vehicle_id, model_name, base_efficiency, mass_kg, drag_coef,
+//   frontal_area, engine_rated_power[, tire_pressure_bar][, has_ac]
+//
+// tire_pressure_bar defaults to 2.4 and has_ac (y/n, yes/no, 1/0,
+// true/false) to no. Fields may be double-quoted, with "" for a quote.
+//
+// The file is streamed: rows are validated as they are read and collected
+// into batches of batchSize vehicles, each written with
+// Storage::upsertVehicles in one transaction - existing vehicles are
+// replaced. A row that fails validation, or repeats an id seen earlier in
+// the file, is reported and skipped. If the backend rejects a whole batch,
+// its rows are retried one by one so only the offending rows are lost; when
+// the first retries all fail too the backend itself is taken to be down and
+// the import stops there.
+class VehicleImporter {
+public:
+    struct RowError {
+        size_t line;            // 1-based, the header is line 1
+        std::string message;
+    };
+
+    struct Result {
+        size_t rows = 0;        // data rows read
+        size_t imported = 0;
+        size_t rejected = 0;
+        size_t batches = 0;
+        size_t retriedBatches = 0;
+        bool stopped = false;   // storage failed; the rest of the file was not read
+        double seconds = 0.0;
+        std::vector<RowError> errors;
+    };
+
+    // With a catalog, writes go through it so it stays current
+    VehicleImporter(Storage* storage, VehicleCatalog* catalog = nullptr, size_t batchSize = 2000);
+
+    // False if the file could not be read or its header is unusable;
+    // row-level problems only show up in `result`
+    bool importFile(const std::string& path, Result& result);
+
+    static void displayResult(const Result& result, size_t maxErrors = 20);
+
+private:
+    Storage* storage;
+    VehicleCatalog* catalog;
+    size_t batchSize;
+
+    int write(const std::vector<Vehicle>& vehicles);
+    // False if the storage refused the batch and every retried row
+    bool flush(std::vector<Vehicle>& batch, std::vector<size_t>& lines, Result& result);
+};
+
+#endif
@@ -7,116 +7,33 @@
 #include <iomanip>
 #include <sstream>
 
-Auth::Auth(DatabaseManager* db) : db(db) {}
+Auth::Auth(Storage* storage) : storage(storage) {}
 
 // public functions
 // password verification
 bool Auth::verify(const std::string& username, const std::string& password) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* query = "SELECT password_hash FROM users WHERE username = ? LIMIT 1";
-
-    if (mysql_stmt_prepare(stmt, query, (unsigned long)strlen(query)) != 0) {
-        std::cerr << "Failed to prepare verification statement.\n";
-        return false;
-    }
-
-    MYSQL_BIND bind[1];
-    memset(bind, 0, sizeof(bind));
-    bind[0].buffer_type = MYSQL_TYPE_STRING;
-    bind[0].buffer = (char*)username.c_str();
-    bind[0].buffer_length = (unsigned long)username.length();
-
-    if (mysql_stmt_bind_param(stmt, bind) != 0) {
-        std::cerr << "Failed to bind parameters for verification.\n";
-        mysql_stmt_close(stmt);
+    UserAccount account;
+    if (!storage->findUser(username, account)) {
         return false;
     }
-
-    if (mysql_stmt_execute(stmt) != 0) {
-        std::cerr << "Failed to execute verification statement.\n";
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    char stored_hash[256] = {0};
-    unsigned long hash_length = 0;
-    MYSQL_BIND res_bind[1];
-    memset(res_bind, 0, sizeof(res_bind));
-    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
-    res_bind[0].buffer = stored_hash;
-    res_bind[0].buffer_length = sizeof(stored_hash);
-    res_bind[0].length = &hash_length;
-
-    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
-        std::cerr << "Failed to bind result for verification.\n";
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    bool authenticated = false;
-
-    if (mysql_stmt_fetch(stmt) == 0) {
-        std::string storedPassword(stored_hash, hash_length);
-        std::string input_hash = password;
-        authenticated = verifyPassword(password, storedPassword);
-    }
-
-    mysql_stmt_close(stmt);
-    return authenticated;
+    return verifyPassword(password, account.passwordHash);
 }
 
 bool Auth::userExists(const std::string& username) {
-    if (!db || !db->getConnection()) return false;
-
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* query = "SELECT COUNT(*) FROM users WHERE username = ?";
+    if (!storage) return false;
 
-    if (mysql_stmt_prepare(stmt, query, (unsigned long)strlen(query)) != 0) return false;
-
-    MYSQL_BIND bind[1];
-    memset(bind, 0, sizeof(bind));
-    bind[0].buffer_type = MYSQL_TYPE_STRING;
-    bind[0].buffer = (char*)username.c_str();
-    bind[0].buffer_length = (unsigned long)username.length();
-
-    if (mysql_stmt_bind_param(stmt, bind) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    if (mysql_stmt_execute(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    int count = 0;
-    MYSQL_BIND res_bind[1];
-    memset(res_bind, 0, sizeof(res_bind));
-    res_bind[0].buffer_type = MYSQL_TYPE_LONG;
-    res_bind[0].buffer = &count;
-
-    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    if (mysql_stmt_fetch(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    mysql_stmt_close(stmt);
-    return (count > 0);
+    UserAccount account;
+    return storage->findUser(username, account);
 }
 
 bool Auth::registerUser(const std::string& username, const std::string& password, Role role) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -140,67 +57,33 @@ bool Auth::registerUser(const std::string& username, const std::string& password
         return false;
     }
 
-    // Check if user already exists
-    if (userExists(username)) {
+    // Password stored as salt:SHA-256
+    UserAccount account;
+    account.username = username;
+    std::string salt = generateSalt();
+    account.passwordHash = salt + ":" + hashPassword(password, salt);
+    account.role = roleToString(role);
+
+    // A taken username comes back as zero rows from the insert itself
+    int inserted = storage->insertUser(account);
+    if (inserted > 0) {
+        std::cout << "✓ User '" << username << "' registered successfully as "
+            << account.role << ".\n";
+        return true;
+    }
+    else if (inserted == 0) {
         std::cerr << "User '" << username << "' already exists.\n";
         return false;
     }
-
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-
-    // Use ENUM strings 'admin' or 'user'
-    const char* sql = "INSERT INTO users (username, password_hash, role) VALUES (?, ?, ?)";
-
-    if (mysql_stmt_prepare(stmt, sql, (unsigned long)strlen(sql)) == 0) {
-        MYSQL_BIND bind[3];
-        memset(bind, 0, sizeof(bind));
-
-        // Username
-        bind[0].buffer_type = MYSQL_TYPE_STRING;
-        bind[0].buffer = (char*)username.c_str();
-        bind[0].buffer_length = (unsigned long)username.length();
-
-        // Password - store as SHA-256
-        bind[1].buffer_type = MYSQL_TYPE_STRING;
-        std::string salt = generateSalt();
-        std::string hashedPassword = hashPassword(password, salt);
-        std::string storedHash = salt + ":" + hashedPassword;
-        bind[1].buffer = (char*)storedHash.c_str();
-        bind[1].buffer_length = (unsigned long)storedHash.length();
-
-        std::string roleStr = roleToString(role);
-        bind[2].buffer_type = MYSQL_TYPE_STRING;
-        bind[2].buffer = (char*)roleStr.c_str();
-        bind[2].buffer_length = (unsigned long)roleStr.length();
-
-        if (mysql_stmt_bind_param(stmt, bind) != 0) {
-            std::cerr << "Failed to bind parameters for registration.\n";
-            mysql_stmt_close(stmt);
-            return false;
-        }
-
-        bool success = (mysql_stmt_execute(stmt) == 0);
-        mysql_stmt_close(stmt);
-
-        if (success) {
-            std::cout << "✓ User '" << username << "' registered successfully as "
-                << roleStr << ".\n";
-            return true;
-        }
-        else {
-            std::cerr << "✗ Failed to register user.\n";
-            return false;
-        }
+    else {
+        std::cerr << "✗ Failed to register user.\n";
+        return false;
     }
-
-    std::cerr << "Failed to prepare registration statement.\n";
-    mysql_stmt_close(stmt);
-    return false;
 }
 
 bool Auth::login(std::string& loggedInUser, Role& loggedInRole) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -213,14 +96,13 @@ bool Auth::login(std::string& loggedInUser, Role& loggedInRole) {
     setEcho(true);
     std::cout << std::endl;
 
-    if (verify(u, p)) {
+    // One lookup gives both the hash to check and the role
+    UserAccount account;
+    if (storage->findUser(u, account) && verifyPassword(p, account.passwordHash)) {
         loggedInUser = u;
-
-        // Get user role
-        if (getUserRole(u, loggedInRole)) {
-            std::cout << "Welcome, " << u << "! (" << roleToString(loggedInRole) << ")\n";
-            return true;
-        }
+        loggedInRole = stringToRole(account.role);
+        std::cout << "Welcome, " << u << "! (" << roleToString(loggedInRole) << ")\n";
+        return true;
     }
     std::cout << "Invalid credentials.\n";
     return false;
@@ -228,8 +110,8 @@ bool Auth::login(std::string& loggedInUser, Role& loggedInRole) {
 
 bool Auth::updateUser(const std::string& currentUser, Role currentRole,const std::string& targetUser, const std::string& newPassword) {
 
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -239,55 +121,27 @@ bool Auth::updateUser(const std::string& currentUser, Role currentRole,const std
         return false;
     }
 
-    // Check if target user exists
-    if (!userExists(targetUser)) {
+    std::string salt = generateSalt();
+    std::string storedHash = salt + ":" + hashPassword(newPassword, salt);
+
+    // Zero matched rows means there is no such user
+    int matched = storage->updatePasswordHash(targetUser, storedHash);
+    if (matched > 0) {
+        std::cout << "User '" << targetUser << "' password updated successfully.\n";
+        return true;
+    }
+    if (matched == 0) {
         std::cerr << "User '" << targetUser << "' does not exist.\n";
         return false;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* sql = "UPDATE users SET password_hash = ? WHERE username = ?";
-
-    if (mysql_stmt_prepare(stmt, sql, (unsigned long)strlen(sql)) == 0) {
-        MYSQL_BIND bind[2];
-        memset(bind, 0, sizeof(bind));
-
-        bind[0].buffer_type = MYSQL_TYPE_STRING;
-        std::string salt = generateSalt();
-        std::string hashedPassword = hashPassword(newPassword, salt);
-        std::string storedHash = salt + ":" + hashedPassword;
-        bind[0].buffer = (char*)storedHash.c_str();
-        bind[0].buffer_length = (unsigned long)storedHash.length();
-        // Target username
-        bind[1].buffer_type = MYSQL_TYPE_STRING;
-        bind[1].buffer = (char*)targetUser.c_str();
-        bind[1].buffer_length = (unsigned long)targetUser.length();
-
-        if (mysql_stmt_bind_param(stmt, bind) != 0) {
-            std::cerr << "Failed to bind parameters for update.\n";
-            mysql_stmt_close(stmt);
-            return false;
-        }
-
-        if (mysql_stmt_execute(stmt) == 0) {
-            int affected = (int)mysql_stmt_affected_rows(stmt);
-            mysql_stmt_close(stmt);
-
-            if (affected > 0) {
-                std::cout << "User '" << targetUser << "' password updated successfully.\n";
-                return true;
-            }
-        }
-    }
-
     std::cerr << "Failed to update user '" << targetUser << "'.\n";
-    mysql_stmt_close(stmt);
     return false;
 }
 
 bool Auth::deleteUser(const std::string& currentUser, Role currentRole, const std::string& targetUser) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -297,12 +151,6 @@ bool Auth::deleteUser(const std::string& currentUser, Role currentRole, const st
         return false;
     }
 
-    // Check if target user exists
-    if (!userExists(targetUser)) {
-        std::cerr << "User '" << targetUser << "' does not exist.\n";
-        return false;
-    }
-
     // Confirmation for deletion
     std::cout << "Are you sure you want to delete user '" << targetUser << "'? (y/n): ";
     char confirm;
@@ -312,91 +160,34 @@ bool Auth::deleteUser(const std::string& currentUser, Role currentRole, const st
         return false;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* sql = "DELETE FROM users WHERE username = ?";
-
-    if (mysql_stmt_prepare(stmt, sql, (unsigned long)strlen(sql)) == 0) {
-        MYSQL_BIND bind[1];
-        memset(bind, 0, sizeof(bind));
-
-        bind[0].buffer_type = MYSQL_TYPE_STRING;
-        bind[0].buffer = (char*)targetUser.c_str();
-        bind[0].buffer_length = (unsigned long)targetUser.length();
-
-        if (mysql_stmt_bind_param(stmt, bind) != 0) {
-            std::cerr << "Failed to bind parameters for deletion.\n";
-            mysql_stmt_close(stmt);
-            return false;
-        }
-
-        if (mysql_stmt_execute(stmt) == 0) {
-            int affected = (int)mysql_stmt_affected_rows(stmt);
-            mysql_stmt_close(stmt);
-
-            if (affected > 0) {
-                std::cout << "User '" << targetUser << "' deleted successfully.\n";
-                return true;
-            }
-        }
+    int deleted = storage->deleteUser(targetUser);
+    if (deleted > 0) {
+        std::cout << "User '" << targetUser << "' deleted successfully.\n";
+        return true;
+    }
+    if (deleted == 0) {
+        std::cerr << "User '" << targetUser << "' does not exist.\n";
+        return false;
     }
 
     std::cerr << "Failed to delete user '" << targetUser << "'.\n";
-    mysql_stmt_close(stmt);
     return false;
 }
 
 bool Auth::getUserRole(const std::string& username, Role& role) {
-    if (!db || !db->getConnection()) return false;
+    if (!storage) return false;
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* query = "SELECT role FROM users WHERE username = ?";
-
-    if (mysql_stmt_prepare(stmt, query, (unsigned long)strlen(query)) != 0) return false;
-
-    MYSQL_BIND bind[1];
-    memset(bind, 0, sizeof(bind));
-    bind[0].buffer_type = MYSQL_TYPE_STRING;
-    bind[0].buffer = (char*)username.c_str();
-    bind[0].buffer_length = (unsigned long)username.length();
-
-    if (mysql_stmt_bind_param(stmt, bind) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    if (mysql_stmt_execute(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    char role_buf[10];
-    unsigned long role_length = 0;
-    MYSQL_BIND res_bind[1];
-    memset(res_bind, 0, sizeof(res_bind));
-    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
-    res_bind[0].buffer = role_buf;
-    res_bind[0].buffer_length = sizeof(role_buf);
-    res_bind[0].length = &role_length;
-
-    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
-        mysql_stmt_close(stmt);
+    UserAccount account;
+    if (!storage->findUser(username, account)) {
         return false;
     }
-
-    if (mysql_stmt_fetch(stmt) == 0) {
-        std::string roleStr(role_buf, role_length);
-        role = stringToRole(roleStr);
-        mysql_stmt_close(stmt);
-        return true;
-    }
-
-    mysql_stmt_close(stmt);
-    return false;
+    role = stringToRole(account.role);
+    return true;
 }
 
 bool Auth::listAllUsers(const std::string& adminUser, Role adminRole) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -406,54 +197,7 @@ bool Auth::listAllUsers(const std::string& adminUser, Role adminRole) {
         return false;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* query = "SELECT username, role FROM users ORDER BY username";
-
-    if (mysql_stmt_prepare(stmt, query, (unsigned long)strlen(query)) != 0) {
-        std::cerr << "Failed to prepare list users statement: "
-            << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    if (mysql_stmt_execute(stmt) != 0) {
-        std::cerr << "Failed to execute list users statement: "
-            << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    // Bind result columns
-    char username_buf[256];
-    char role_buf[10];
-    unsigned long username_len = 0;
-    unsigned long role_len = 0;
-
-    MYSQL_BIND res_bind[2];
-    memset(res_bind, 0, sizeof(res_bind));
-
-    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
-    res_bind[0].buffer = username_buf;
-    res_bind[0].buffer_length = sizeof(username_buf);
-    res_bind[0].length = &username_len;
-
-    res_bind[1].buffer_type = MYSQL_TYPE_STRING;
-    res_bind[1].buffer = role_buf;
-    res_bind[1].buffer_length = sizeof(role_buf);
-    res_bind[1].length = &role_len;
-
-    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
-        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    // Store results
-    if (mysql_stmt_store_result(stmt) != 0) {
-        std::cerr << "Failed to store result: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
-        return false;
-    }
+    std::vector<UserAccount> users = storage->listUsers();
 
     std::cout << "\n=== All Registered Users ===\n";
     std::cout << std::left << std::setw(20) << "Username"
@@ -462,27 +206,22 @@ bool Auth::listAllUsers(const std::string& adminUser, Role adminRole) {
         << "\n";
     std::cout << std::string(40, '-') << "\n";
 
-    int count = 0;
-    while (mysql_stmt_fetch(stmt) == 0) {
-        std::string username(username_buf, username_len);
-        std::string roleStr(role_buf, role_len);
-        std::string status = (username == adminUser) ? "(You)" : "";
+    for (const UserAccount& user : users) {
+        std::string status = (user.username == adminUser) ? "(You)" : "";
 
-        std::cout << std::left << std::setw(20) << username
-            << std::setw(10) << roleStr
+        std::cout << std::left << std::setw(20) << user.username
+            << std::setw(10) << user.role
             << std::setw(10) << status
             << "\n";
-        count++;
     }
 
-    std::cout << "\nTotal users: " << count << "\n";
-    mysql_stmt_close(stmt);
+    std::cout << "\nTotal users: " << users.size() << "\n";
     return true;
 }
 
 bool Auth::changeUserRole(const std::string& adminUser, Role adminRole, const std::string& targetUser, Role newRole) {
-    if (!db || !db->getConnection()) {
-        std::cerr << "Database connection not available.\n";
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
         return false;
     }
 
@@ -492,55 +231,24 @@ bool Auth::changeUserRole(const std::string& adminUser, Role adminRole, const st
         return false;
     }
 
-    // Check if target user exists
-    if (!userExists(targetUser)) {
-        std::cerr << "User '" << targetUser << "' does not exist.\n";
-        return false;
-    }
-
     if (adminUser == targetUser) {
         std::cerr << "Cannot change your own role.\n";
         return false;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(db->getConnection());
-    const char* sql = "UPDATE users SET role = ? WHERE username = ?";
-
-    if (mysql_stmt_prepare(stmt, sql, (unsigned long)strlen(sql)) == 0) {
-        MYSQL_BIND bind[2];
-        memset(bind, 0, sizeof(bind));
-
-        // New role as ENUM string
-        std::string roleStr = roleToString(newRole);
-        bind[0].buffer_type = MYSQL_TYPE_STRING;
-        bind[0].buffer = (char*)roleStr.c_str();
-        bind[0].buffer_length = (unsigned long)roleStr.length();
-
-        // Target username
-        bind[1].buffer_type = MYSQL_TYPE_STRING;
-        bind[1].buffer = (char*)targetUser.c_str();
-        bind[1].buffer_length = (unsigned long)targetUser.length();
-
-        if (mysql_stmt_bind_param(stmt, bind) != 0) {
-            std::cerr << "Failed to bind parameters for role change.\n";
-            mysql_stmt_close(stmt);
-            return false;
-        }
-
-        if (mysql_stmt_execute(stmt) == 0) {
-            int affected = (int)mysql_stmt_affected_rows(stmt);
-            mysql_stmt_close(stmt);
-
-            if (affected > 0) {
-                std::cout << "User '" << targetUser << "' role changed to "
-                    << roleStr << ".\n";
-                return true;
-            }
-        }
+    std::string roleStr = roleToString(newRole);
+    int matched = storage->updateRole(targetUser, roleStr);
+    if (matched > 0) {
+        std::cout << "User '" << targetUser << "' role changed to "
+            << roleStr << ".\n";
+        return true;
+    }
+    if (matched == 0) {
+        std::cerr << "User '" << targetUser << "' does not exist.\n";
+        return false;
     }
 
     std::cerr << "Failed to change role for user '" << targetUser << "'.\n";
-    mysql_stmt_close(stmt);
     return false;
 }
 
@@ -0,0 +1,39 @@
+#include "Calculation_Record.h"
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+std::string CalculationRecord::getFormattedDate() const {
+    if (calculated_at.empty()) return "Unknown";
+
+    std::tm tm = {};
+    std::istringstream ss(calculated_at);
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+
+    if (ss.fail()) {
+   
+        return calculated_at;
+    }
+
+    char buffer[80];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", &tm);
+    return std::string(buffer);
+}
+
+double CalculationRecord::getTotalFuelCost() const {
+    return fuel_consumed_liters * 2.0;
+}
+
+std::string CalculationRecord::currentTimestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char buffer[20];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    return buffer;
+}
@@ -1,40 +1,43 @@
 #include "Calculator.h"
 #include "Vehicle.h"
 #include "Environment.h"
+#include "Efficiency_Table.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
-double Calculator::calculate(Vehicle& veh, Environment& env, double distanceKm, double avgSpeedKmh) {
+double Calculator::calculate(const Vehicle& veh, const Environment& env, double distanceKm, double avgSpeedKmh) const {
+    return fuelLiters(veh.currentCoefficients(), veh.hasAC, env.roadGradient, env.surfaceRoughness,
+        env.ambientTempC, env.pressurePa, distanceKm, avgSpeedKmh);
+}
+
+double Calculator::fuelLiters(const VehicleCoefficients& c, bool hasAC,
+    double roadGradient, double surfaceRoughness, double ambientTempC,
+    double pressurePa, double distanceKm, double avgSpeedKmh) {
 
     // 1. Convert units to SI
     double v = avgSpeedKmh / 3.6; // m/s
     double durationSec = (distanceKm * 1000.0) / v;
-    double g = 9.81;
-    double rho = env.getAirDensity();
+    double rho = Environment::airDensity(ambientTempC, pressurePa);
 
-    double C_rr = env.surfaceRoughness * std::pow(veh.tirePressureBar, -0.477);
-    double F_roll = C_rr * veh.massKg * g * std::cos(std::atan(env.roadGradient));
+    double F_roll = surfaceRoughness * c.rollFactor * std::cos(std::atan(roadGradient));
 
-    double F_aero = 0.5 * rho * veh.dragCoef * veh.frontalArea * std::pow(v, 2);
+    double F_aero = c.aeroFactor * rho * v * v;
 
-    double F_grade = veh.massKg * g * std::sin(std::atan(env.roadGradient));
+    double F_grade = c.weightN * std::sin(std::atan(roadGradient));
 
     double F_total = F_roll + F_aero + F_grade;
     double P_wheels = (std::max)(0.0, F_total * v);
 
     double P_aux = 300.0;
-    if (veh.hasAC && env.ambientTempC > 20.0) {
+    if (hasAC && ambientTempC > 20.0) {
         P_aux += 4000.0;
     }
 
     double P_required = (P_wheels / 0.85) + P_aux;
-    double load_factor = P_required / (veh.engineRatedPower * 1000.0);
-
-    double x = std::clamp(load_factor, 0.2, 1.0);
-    double efficiency = 0.5968 * x - 0.1666 * pow(x, 2) + 2.4968 * pow(x, 3) - 2.1128 + 0.4;
+    double load_factor = P_required / c.ratedPowerW;
 
-    efficiency = std::clamp(efficiency, 0.30, 0.45);
+    double efficiency = engineEfficiency(load_factor);
 
     double totalEnergyJoule = P_required * durationSec;
     double fuelMassKg = totalEnergyJoule / (43000000.0 * efficiency);
@@ -42,6 +45,44 @@ double Calculator::calculate(Vehicle& veh, Environment& env, double distanceKm,
     return fuelMassKg / 0.832;
 }
 
+// Tabulated cubic, see Efficiency_Table.h for the error bound
+double Calculator::engineEfficiency(double loadFactor) {
+    return EfficiencyTable::lookup(loadFactor);
+}
+
+double Calculator::calculateRoute(const Vehicle& veh, const Route& route, double pressurePa) const {
+    // Per-vehicle terms, constant across all segments
+    VehicleCoefficients c = veh.currentCoefficients();
+
+    double fuelMassKg = 0.0;
+    for (const RouteSegment& seg : route.segments) {
+        double v = seg.speedKmh / 3.6; // m/s
+        double durationSec = (seg.lengthKm * 1000.0) / v;
+        double rho = Environment::airDensity(seg.temperatureC, pressurePa);
+
+        // cos(atan(g)) and sin(atan(g)) without the trig calls
+        double invHyp = 1.0 / std::sqrt(1.0 + seg.gradient * seg.gradient);
+
+        double F_roll = seg.roughness * c.rollFactor * invHyp;
+        double F_aero = c.aeroFactor * rho * v * v;
+        double F_grade = c.weightN * seg.gradient * invHyp;
+
+        double P_wheels = (std::max)(0.0, (F_roll + F_aero + F_grade) * v);
+
+        double P_aux = 300.0;
+        if (veh.hasAC && seg.temperatureC > 20.0) {
+            P_aux += 4000.0;
+        }
+
+        double P_required = (P_wheels / 0.85) + P_aux;
+        double efficiency = engineEfficiency(P_required / c.ratedPowerW);
+
+        fuelMassKg += (P_required * durationSec) / (43000000.0 * efficiency);
+    }
+
+    return fuelMassKg / 0.832;
+}
+
 void Calculator::displayReport(double finalEfficiency, double distanceKm) {
     std::cout << "\n--- Mission Report ---" << std::endl;
     std::cout << "Fuel Consumed: " << finalEfficiency << " L" << std::endl;
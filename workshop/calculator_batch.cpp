@@ -0,0 +1,290 @@
+#include "Calculator.h"
+#include "Batch_Lanes.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+// Batch form of Calculator::calculate.
+//
+// A single kernel body (missionKernel) is instantiated per lane type and
+// feature combination:
+//   lanes: AVX2 double x4, AVX2 float x8, scalar double, scalar float
+//   AC:    per-mission AC load vs. no AC anywhere in the batch
+//   FLAT:  every gradient zero (no slope terms) vs. general gradients
+// calculateBatch() inspects the batch once and picks the instantiation; the
+// scalar lanes of the same kernel finish the remainder and cover non-AVX2
+// builds.
+//
+// The trigonometry is replaced by the exact identities
+//   cos(atan(g)) = 1 / sqrt(1 + g^2),  sin(atan(g)) = g / sqrt(1 + g^2)
+// and pow(p, -0.477) by exp(-0.477 * log(p)) with polynomials sized for each
+// precision. On steep descents the grade force nearly cancels rolling and
+// drag, and any rounding in those forces is magnified in the small remainder.
+// The float kernels therefore sum the forces in double lanes and keep float
+// for the tire-pressure power, trip time, efficiency lookup and fuel. Missions
+// where a remaining rounding error could still be magnified past the
+// tolerance are flagged: float ones are recomputed in the double lanes, and
+// the few the double lanes flag with calculate()'s own scalar code. The
+// relative error against calculate() then stays near 1e-13 in double and
+// below 1e-5 in float. A batch for a single
+// vehicle (MissionBatch::vehicle) broadcasts its precomputed coefficients and
+// skips the vehicle terms, the tire-pressure power among them, entirely.
+
+namespace {
+
+    using namespace BatchLanes;
+
+    // On a descent the grade force cancels rolling and drag, and the
+    // rounding of those forces grows by (sum of their magnitudes) /
+    // P_required. In the float kernels only the rolling force carries float
+    // rounding (from the tire factor), so there the ratio is F_roll /
+    // P_required. Missions where the ratio passes the limit for the lane
+    // precision - and the wheels are not plainly coasting - are recomputed.
+    const double FLOAT_CANCELLATION_LIMIT = 4.0;
+    const double DOUBLE_CANCELLATION_LIMIT = 50.0;
+
+    // Evaluates missions from index i in steps of L::WIDTH and returns the
+    // first index left unprocessed. Indices of missions past
+    // `cancellationLimit` are appended to `redo`.
+    //
+    // The forces and the power they sum to are formed in L::Wide (double)
+    // lanes, read straight from the double inputs; only the tire factor
+    // comes from L lanes. Trip time, engine efficiency and fuel run in L.
+    template <typename L, bool AC, bool FLAT>
+    size_t missionKernel(const MissionBatch& b, size_t i, double* out,
+        double cancellationLimit, std::vector<size_t>& redo) {
+        using V = typename L::Vec;
+        using W = typename L::Wide;
+        using WV = typename W::Vec;
+        constexpr size_t PARTS = L::WIDTH / W::WIDTH;
+        constexpr bool NARROW_TIRE = !std::is_same<L, W>::value;
+
+        const WV g = W::set1(9.81);
+        const WV one = W::set1(1.0);
+        const WV zero = W::set1(0.0);
+        const WV seaLevel = W::set1(101325.0);
+        const WV coasting = W::set1(-1e-5);
+
+        const VehicleCoefficients* shared = b.vehicle;
+        const WV sharedWeight = W::set1(shared ? shared->weightN : 0.0);
+        const WV sharedRoll = W::set1(shared ? shared->rollFactor : 0.0);
+        const WV sharedAero = W::set1(shared ? shared->aeroFactor : 0.0);
+        const V sharedPower = L::set1(shared ? shared->ratedPowerW : 0.0);
+
+        // A shared vehicle's rolling factor comes precomputed in double
+        const bool flagging = !(NARROW_TIRE && shared);
+        const WV limit = W::set1(cancellationLimit * 0.85);
+
+        for (; i + L::WIDTH <= b.count; i += L::WIDTH) {
+            V tire = shared ? L::set1(0.0) : L::tireFactor(L::load(b.tirePressureBar + i));
+
+            WV required[PARTS];
+            int lanes = 0;
+            for (size_t part = 0; part < PARTS; ++part) {
+                size_t j = i + part * W::WIDTH;
+
+                // Vehicle terms, as in VehicleCoefficients
+                WV mg, rollFactor, aeroFactor;
+                if (shared) {
+                    mg = sharedWeight;
+                    rollFactor = sharedRoll;
+                    aeroFactor = sharedAero;
+                }
+                else {
+                    mg = W::load(b.massKg + j) * g;
+                    rollFactor = mg * L::widen(tire, part);
+                    aeroFactor = W::set1(0.5) * (W::load(b.dragCoef + j) * W::load(b.frontalArea + j));
+                }
+
+                WV rough = W::load(b.surfaceRoughness + j);
+                WV temp = W::load(b.ambientTempC + j);
+                WV press = b.pressurePa ? W::load(b.pressurePa + j) : seaLevel;
+
+                // 1. Convert units to SI
+                WV v = W::load(b.avgSpeedKmh + j) / W::set1(3.6);
+                WV rho = press / (W::set1(287.058) * (temp + W::set1(273.15)));
+
+                WV F_aero = aeroFactor * rho * (v * v);
+
+                // Every term is positive on a flat road; only a slope can cancel
+                WV F_total, F_spread = zero, F_roll = zero;
+                if constexpr (FLAT) {
+                    // cos = 1, sin = 0
+                    F_total = rough * rollFactor + F_aero;
+                }
+                else {
+                    WV grad = W::load(b.roadGradient + j);
+                    WV invHyp = one / W::sqrt(one + grad * grad);
+                    F_roll = rough * rollFactor * invHyp;
+                    WV F_grade = mg * (grad * invHyp);
+                    F_total = F_roll + F_aero + F_grade;
+                    F_spread = F_roll + F_aero + W::max(F_grade, zero - F_grade);
+                }
+                WV P_wheels = W::max(zero, F_total * v);
+
+                WV P_aux = W::set1(300.0);
+                if constexpr (AC) {
+                    P_aux = P_aux + W::acPower(b.hasAC + j, temp);
+                }
+
+                required[part] = P_wheels / W::set1(0.85) + P_aux;
+
+                if (!FLAT && flagging) {
+                    WV spreadPower = F_spread * v;
+                    WV exposed = NARROW_TIRE ? F_roll * v : spreadPower;
+                    lanes |= (W::greater(exposed, required[part] * limit)
+                        & W::greater(F_total * v, spreadPower * coasting)) << (part * W::WIDTH);
+                }
+            }
+            for (size_t k = 0; lanes != 0; ++k, lanes >>= 1) {
+                if (lanes & 1) redo.push_back(i + k);
+            }
+
+            V P_required = L::narrow(required);
+            V ratedPowerW = shared ? sharedPower : L::load(b.engineRatedPower + i) * L::set1(1000.0);
+            V durationSec = (L::load(b.distanceKm + i) * L::set1(1000.0)) / (L::load(b.avgSpeedKmh + i) / L::set1(3.6));
+
+            V load_factor = P_required / ratedPowerW;
+            V efficiency = L::efficiency(load_factor);
+
+            V totalEnergyJoule = P_required * durationSec;
+            V fuelMassKg = totalEnergyJoule / (L::set1(43000000.0) * efficiency);
+
+            L::store(out + i, fuelMassKg / L::set1(0.832));
+        }
+        return i;
+    }
+
+    template <typename T, bool AC, bool FLAT>
+    void runBatch(const MissionBatch& b, double* out, std::vector<size_t>& redo) {
+        const double limit = sizeof(T) == sizeof(float) ? FLOAT_CANCELLATION_LIMIT : DOUBLE_CANCELLATION_LIMIT;
+        size_t i = 0;
+#if defined(__AVX2__)
+        if constexpr (sizeof(T) == sizeof(float)) i = missionKernel<AvxFloatLanes, AC, FLAT>(b, i, out, limit, redo);
+        else i = missionKernel<AvxDoubleLanes, AC, FLAT>(b, i, out, limit, redo);
+#endif
+        missionKernel<ScalarLanes<T>, AC, FLAT>(b, i, out, limit, redo);
+    }
+
+    template <typename T>
+    void dispatchFeatures(const MissionBatch& b, double* out, bool ac, bool flat, std::vector<size_t>& redo) {
+        if (ac) {
+            if (flat) runBatch<T, true, true>(b, out, redo);
+            else runBatch<T, true, false>(b, out, redo);
+        }
+        else {
+            if (flat) runBatch<T, false, true>(b, out, redo);
+            else runBatch<T, false, false>(b, out, redo);
+        }
+    }
+
+    // Missions [first, first + n) of `b` as a batch of their own
+    MissionBatch slice(const MissionBatch& b, size_t first, size_t n) {
+        auto at = [first](const double* column) { return column ? column + first : nullptr; };
+        MissionBatch part = b;
+        part.count = n;
+        part.massKg = at(b.massKg);
+        part.dragCoef = at(b.dragCoef);
+        part.frontalArea = at(b.frontalArea);
+        part.tirePressureBar = at(b.tirePressureBar);
+        part.engineRatedPower = at(b.engineRatedPower);
+        part.hasAC = b.hasAC ? b.hasAC + first : nullptr;
+        part.roadGradient = at(b.roadGradient);
+        part.surfaceRoughness = at(b.surfaceRoughness);
+        part.ambientTempC = at(b.ambientTempC);
+        part.pressurePa = at(b.pressurePa);
+        part.distanceKm = at(b.distanceKm);
+        part.avgSpeedKmh = at(b.avgSpeedKmh);
+        return part;
+    }
+
+    // Runs the missions at `indices` again through the double lanes and
+    // writes their results back to `out`. On return `indices` holds those
+    // the double lanes flag in turn.
+    void rerunInDouble(const MissionBatch& b, double* out, bool ac, std::vector<size_t>& indices) {
+        const size_t GATHER = 256;
+        double columns[11][GATHER];
+        double liters[GATHER];
+        bool hasAC[GATHER];
+        std::vector<size_t> flagged;
+        size_t kept = 0;
+
+        for (size_t first = 0; first < indices.size(); first += GATHER) {
+            size_t n = (std::min)(GATHER, indices.size() - first);
+            const size_t* at = indices.data() + first;
+            int column = 0;
+            auto gather = [&](const double* source) -> const double* {
+                if (!source) return nullptr;
+                double* dest = columns[column++];
+                for (size_t k = 0; k < n; ++k) dest[k] = source[at[k]];
+                return dest;
+            };
+
+            MissionBatch sub;
+            sub.count = n;
+            sub.vehicle = b.vehicle;
+            sub.massKg = gather(b.massKg);
+            sub.dragCoef = gather(b.dragCoef);
+            sub.frontalArea = gather(b.frontalArea);
+            sub.tirePressureBar = gather(b.tirePressureBar);
+            sub.engineRatedPower = gather(b.engineRatedPower);
+            sub.roadGradient = gather(b.roadGradient);
+            sub.surfaceRoughness = gather(b.surfaceRoughness);
+            sub.ambientTempC = gather(b.ambientTempC);
+            sub.pressurePa = gather(b.pressurePa);
+            sub.distanceKm = gather(b.distanceKm);
+            sub.avgSpeedKmh = gather(b.avgSpeedKmh);
+            if (b.hasAC) {
+                for (size_t k = 0; k < n; ++k) hasAC[k] = b.hasAC[at[k]];
+                sub.hasAC = hasAC;
+            }
+
+            flagged.clear();
+            dispatchFeatures<double>(sub, liters, ac, false, flagged);
+            for (size_t k = 0; k < n; ++k) out[at[k]] = liters[k];
+            // Written slots all lie behind the ones still to be read
+            for (size_t k : flagged) indices[kept++] = at[k];
+        }
+        indices.resize(kept);
+    }
+
+} // namespace
+
+void Calculator::calculateBatch(const MissionBatch& b, double* litersOut, Precision precision) const {
+    if (b.count == 0) return;
+
+    // Pick the specialization once for the whole batch
+    bool ac = b.hasAC && std::any_of(b.hasAC, b.hasAC + b.count, [](bool on) { return on; });
+    bool flat = std::all_of(b.roadGradient, b.roadGradient + b.count, [](double grad) { return grad == 0.0; });
+
+    // Slices keep the missions to redo few enough to stay in cache
+    const size_t SLICE = 4096;
+    std::vector<size_t> redo;
+    redo.reserve(SLICE);
+
+    for (size_t first = 0; first < b.count; first += SLICE) {
+        MissionBatch part = slice(b, first, (std::min)(SLICE, b.count - first));
+        double* out = litersOut + first;
+
+        redo.clear();
+        if (precision == Precision::FLOAT) {
+            dispatchFeatures<float>(part, out, ac, flat, redo);
+            // Missions too ill-conditioned for float get the double lanes first
+            if (!redo.empty()) rerunInDouble(part, out, ac, redo);
+        }
+        else {
+            dispatchFeatures<double>(part, out, ac, flat, redo);
+        }
+
+        for (size_t i : redo) {
+            VehicleCoefficients own;
+            if (!part.vehicle) {
+                own = VehicleCoefficients(part.massKg[i], part.dragCoef[i], part.frontalArea[i],
+                    part.tirePressureBar[i], part.engineRatedPower[i]);
+            }
+            out[i] = fuelLiters(part.vehicle ? *part.vehicle : own, part.hasAC && part.hasAC[i],
+                part.roadGradient[i], part.surfaceRoughness[i], part.ambientTempC[i],
+                part.pressurePa ? part.pressurePa[i] : 101325.0, part.distanceKm[i], part.avgSpeedKmh[i]);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include "Cost.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// Storage-independent parts of Cost; loading and saving the fuel price stay
+// in cost.cpp.
+
+// Initialize static members
+double Cost::fuelPrice = 2.0; // Default price: RM 2.00 per liter
+bool Cost::initialized = false;
+
+// Default constructor
+Cost::Cost() : storage(nullptr) {
+    // Default constructor doesn't load from storage
+}
+
+double Cost::calculate(double km_per_liter) const {
+    if (km_per_liter <= 0) {
+        return 0.0;
+    }
+    return fuelPrice / km_per_liter; // RM per km
+}
+
+double Cost::calculateTotalCost(double fuel_liters) const {
+    return fuel_liters * fuelPrice;
+}
+
+void Cost::setFuelPrice(double price) {
+    if (price > 0) {
+        fuelPrice = price;
+        std::cout << "Fuel price updated to RM " << std::fixed << std::setprecision(2) << price << " per liter.\n";
+
+        // Note: Cannot save to database from static method without a Cost instance
+        // The saving will need to be done elsewhere (e.g., in System class)
+    }
+    else {
+        std::cerr << "Error: Fuel price must be positive.\n";
+    }
+}
+
+double Cost::getFuelPrice() {
+    return fuelPrice;
+}
+
+void Cost::displayCurrentPrice() const {
+    std::cout << "Current Fuel Price: RM " << std::fixed << std::setprecision(2) << fuelPrice << " per liter\n";
+}
+
+std::string Cost::getFormattedPrice() const {
+    std::ostringstream oss;
+    oss << "RM " << std::fixed << std::setprecision(2) << fuelPrice << "/L";
+    return oss.str();
+}
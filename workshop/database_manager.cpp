@@ -1,10 +1,118 @@
 #include "Database_Manager.h"
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 
-DatabaseManager::DatabaseManager() : conn(nullptr) {}
+namespace {
+
+    // Connection bound to the current thread by a Lease
+    struct ThreadBinding {
+        const DatabaseManager* owner = nullptr;
+        MYSQL* conn = nullptr;
+    };
+    thread_local ThreadBinding boundConnection;
+
+    // The client library needs per-thread state on every thread that talks to
+    // the server; released when the thread exits.
+    struct ClientThread {
+        bool initialized = false;
+        void ensure() {
+            if (!initialized) {
+                mysql_thread_init();
+                initialized = true;
+            }
+        }
+        ~ClientThread() {
+            if (initialized) mysql_thread_end();
+        }
+    };
+    thread_local ClientThread clientThread;
+
+    // UPDATE reports the rows it matched rather than the rows it changed, so
+    // one statement both applies a change and tells whether the row exists
+    const unsigned long CONNECTION_FLAGS = CLIENT_FOUND_ROWS;
+
+    // Statement this thread last executed: fetch() and finish() on it skip the
+    // locked lookup. Refreshed by every execute(), which always comes first.
+    struct LastExecuted {
+        const DatabaseManager* owner = nullptr;
+        MYSQL_STMT* stmt = nullptr;
+        void* timing = nullptr;   // DatabaseManager::StatementTiming
+    };
+    thread_local LastExecuted lastExecuted;
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+DatabaseManager::Lease::Lease(DatabaseManager* owner, MYSQL* conn)
+    : owner(owner), conn(conn),
+      previousOwner(boundConnection.owner), previousConn(boundConnection.conn) {
+    boundConnection.owner = owner;
+    boundConnection.conn = conn;
+}
+
+DatabaseManager::Lease::Lease(Lease&& other) noexcept
+    : owner(other.owner), conn(other.conn),
+      previousOwner(other.previousOwner), previousConn(other.previousConn) {
+    other.owner = nullptr;
+    other.conn = nullptr;
+}
+
+DatabaseManager::Lease& DatabaseManager::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        owner = other.owner;
+        conn = other.conn;
+        previousOwner = other.previousOwner;
+        previousConn = other.previousConn;
+        other.owner = nullptr;
+        other.conn = nullptr;
+    }
+    return *this;
+}
+
+DatabaseManager::Lease::~Lease() {
+    release();
+}
+
+void DatabaseManager::Lease::release() {
+    if (!conn) return;
+
+    if (boundConnection.conn == conn) {
+        boundConnection.owner = previousOwner;
+        boundConnection.conn = previousConn;
+    }
+    owner->giveBack(conn);
+    owner = nullptr;
+    conn = nullptr;
+}
+
+DatabaseManager::DatabaseManager()
+    : conn(nullptr), port(0), minSize(2), maxSize(8),
+      validateAfter(std::chrono::seconds(5)), openCount(0),
+      statementPrepares(0), statementReuses(0) {}
 
 DatabaseManager::~DatabaseManager() {
-    if (conn) mysql_close(conn);
+    std::lock_guard<std::mutex> guard(poolLock);
+    for (Pooled& pooled : idle) {
+        closeConnection(pooled.conn);
+    }
+    idle.clear();
+    if (conn) closeConnection(conn);
+}
+
+void DatabaseManager::setPoolLimits(size_t minSize, size_t maxSize) {
+    std::lock_guard<std::mutex> guard(poolLock);
+    this->maxSize = (std::max)(maxSize, size_t(1));
+    this->minSize = (std::min)(minSize, this->maxSize);
+}
+
+void DatabaseManager::setValidationInterval(std::chrono::milliseconds idleTime) {
+    std::lock_guard<std::mutex> guard(poolLock);
+    validateAfter = idleTime;
 }
 
 bool DatabaseManager::connect(const std::string& host,
@@ -12,22 +120,386 @@ bool DatabaseManager::connect(const std::string& host,
     const std::string& pass,
     const std::string& db,
     unsigned int port) {
+    // Must run once before any threads use the client library
+    static const bool libraryReady = mysql_library_init(0, nullptr, nullptr) == 0;
+    if (!libraryReady) {
+        std::cerr << "MySQL library initialization failed\n";
+        return false;
+    }
+
+    this->host = host;
+    this->user = user;
+    this->pass = pass;
+    this->dbName = db;
+    this->port = port;
+
     conn = mysql_init(0);
     if (!conn) {
         std::cerr << "MySQL init failed\n";
         return false;
     }
 
-    conn = mysql_real_connect(conn, host.c_str(), user.c_str(),
-        pass.c_str(), db.c_str(), port, NULL, 0);
-    if (conn) {
-        std::cout << "Connected to MySQL database: " << db << std::endl;
-        return true;
-    }
-    else {
+    if (!mysql_real_connect(conn, host.c_str(), user.c_str(),
+        pass.c_str(), db.c_str(), port, NULL, CONNECTION_FLAGS)) {
         std::cerr << "MySQL connection failed: " << mysql_error(conn) << std::endl;
+        mysql_close(conn);
+        conn = nullptr;
         return false;
     }
+    std::cout << "Connected to MySQL database: " << db << std::endl;
+    primaryLastUsed = std::chrono::steady_clock::now();
+
+    // Warm the pool; a short pool is not fatal, it grows on demand
+    std::vector<Pooled> opened;
+    for (size_t i = 0; i < minSize; ++i) {
+        MYSQL* handle = openConnection();
+        if (!handle) break;
+        opened.push_back({ handle, std::chrono::steady_clock::now() });
+    }
+
+    std::lock_guard<std::mutex> guard(poolLock);
+    openCount += opened.size();
+    idle.insert(idle.end(), opened.begin(), opened.end());
+    stats.size = openCount;
+    stats.idle = idle.size();
+    return true;
+}
+
+MYSQL* DatabaseManager::getConnection() {
+    if (boundConnection.owner == this) {
+        return boundConnection.conn;
+    }
+    if (!conn) return nullptr;
+
+    // The menus leave the primary connection idle for as long as the user
+    // likes, so it is checked like a pooled one before it is handed out
+    std::lock_guard<std::mutex> guard(primaryLock);
+    auto now = std::chrono::steady_clock::now();
+    if (now - primaryLastUsed >= validateAfter && mysql_ping(conn) != 0) {
+        // Dropped by the server (wait_timeout, restart); replace it. If it
+        // cannot be reopened yet the dead handle is kept, its calls fail,
+        // and the next one tries again
+        MYSQL* reopened = openConnection();
+        if (!reopened) return conn;
+        closeConnection(conn);
+        conn = reopened;
+
+        std::lock_guard<std::mutex> poolGuard(poolLock);
+        ++stats.reconnects;
+    }
+    primaryLastUsed = now;
+    return conn;
+}
+
+MYSQL* DatabaseManager::openConnection() {
+    clientThread.ensure();
+
+    MYSQL* handle = mysql_init(0);
+    if (!handle) {
+        std::cerr << "MySQL init failed\n";
+        return nullptr;
+    }
+    if (!mysql_real_connect(handle, host.c_str(), user.c_str(),
+        pass.c_str(), dbName.c_str(), port, NULL, CONNECTION_FLAGS)) {
+        std::cerr << "MySQL pooled connection failed: " << mysql_error(handle) << std::endl;
+        mysql_close(handle);
+        return nullptr;
+    }
+    return handle;
+}
+
+void DatabaseManager::closeConnection(MYSQL* handle) {
+    // A new handle may reuse the address, so its statements must go first
+    {
+        std::lock_guard<std::mutex> guard(statementLock);
+        auto it = statementCaches.find(handle);
+        if (it != statementCaches.end()) {
+            for (auto& entry : it->second.statements) {
+                closeStatement(entry.second);
+            }
+            statementCaches.erase(it);
+        }
+    }
+    mysql_close(handle);
 }
 
-MYSQL* DatabaseManager::getConnection() { return conn; }
+MYSQL_STMT* DatabaseManager::prepare(const std::string& sql) {
+    MYSQL* handle = getConnection();
+    if (!handle) {
+        std::cerr << "Database connection not available.\n";
+        return nullptr;
+    }
+
+    // Only the thread holding this connection touches its cache entry, so the
+    // lock guards the map itself; entries stay put when it rehashes
+    unsigned long session = mysql_thread_id(handle);
+    StatementCache* cache;
+    {
+        std::lock_guard<std::mutex> guard(statementLock);
+        cache = &statementCaches[handle];
+        if (cache->threadId != session) {
+            // Reconnected: the server has already discarded these statements
+            for (auto& entry : cache->statements) {
+                closeStatement(entry.second);
+            }
+            cache->statements.clear();
+            cache->threadId = session;
+        }
+
+        auto it = cache->statements.find(sql);
+        if (it != cache->statements.end()) {
+            ++statementReuses;
+            return it->second;
+        }
+    }
+
+    MYSQL_STMT* stmt = mysql_stmt_init(handle);
+    if (!stmt) {
+        std::cerr << "Failed to allocate statement: " << mysql_error(handle) << std::endl;
+        return nullptr;
+    }
+    if (mysql_stmt_prepare(stmt, sql.c_str(), (unsigned long)sql.length()) != 0) {
+        std::cerr << "Failed to prepare statement: " << mysql_stmt_error(stmt) << std::endl;
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    QueryLog::Entry* entry = queryLog.entry(sql);
+    queryLog.addRoundTrips(entry, 1);
+
+    std::lock_guard<std::mutex> guard(statementLock);
+    cache->statements.emplace(sql, stmt);
+    statementTimings[stmt].entry = entry;
+    ++statementPrepares;
+    return stmt;
+}
+
+void DatabaseManager::closeStatement(MYSQL_STMT* stmt) {
+    statementTimings.erase(stmt);
+    mysql_stmt_close(stmt);
+}
+
+DatabaseManager::StatementTiming* DatabaseManager::timingOf(MYSQL_STMT* stmt) {
+    std::lock_guard<std::mutex> guard(statementLock);
+    auto it = statementTimings.find(stmt);
+    return it != statementTimings.end() ? &it->second : nullptr;
+}
+
+void DatabaseManager::finish(MYSQL_STMT* stmt) {
+    if (!stmt) return;
+
+    StatementTiming* timing = (lastExecuted.owner == this && lastExecuted.stmt == stmt)
+        ? static_cast<StatementTiming*>(lastExecuted.timing) : timingOf(stmt);
+    if (timing && timing->pending) {
+        timing->pending = false;
+        queryLog.addRows(timing->entry, timing->rows);
+        if (queryLog.isSlow(timing->elapsed)) {
+            queryLog.logSlow(timing->entry, timing->elapsed, timing->rows);
+        }
+    }
+    mysql_stmt_free_result(stmt);
+}
+
+bool DatabaseManager::execute(MYSQL_STMT* stmt) {
+    StatementTiming* timing = timingOf(stmt);
+    if (timing && timing->pending) {
+        finish(stmt);   // previous result never finished; log it now
+    }
+    lastExecuted.owner = this;
+    lastExecuted.stmt = stmt;
+    lastExecuted.timing = timing;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = mysql_stmt_execute(stmt) == 0;
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!timing) {
+        return ok;   // not from prepare()
+    }
+    if (ok && mysql_stmt_field_count(stmt) > 0) {
+        // Result set: rows are counted by fetch() and the slow-query check
+        // waits for finish() so the log line has them
+        queryLog.record(timing->entry, elapsed, 0, 1, true);
+        timing->pending = true;
+        timing->elapsed = elapsed;
+        timing->rows = 0;
+    }
+    else {
+        uint64_t rows = ok ? (uint64_t)mysql_stmt_affected_rows(stmt) : 0;
+        queryLog.record(timing->entry, elapsed, rows, 1, ok);
+        if (queryLog.isSlow(elapsed)) {
+            queryLog.logSlow(timing->entry, elapsed, rows);
+        }
+    }
+    return ok;
+}
+
+int DatabaseManager::fetch(MYSQL_STMT* stmt) {
+    int status = mysql_stmt_fetch(stmt);
+    if (status == 0 || status == MYSQL_DATA_TRUNCATED) {
+        StatementTiming* timing = (lastExecuted.owner == this && lastExecuted.stmt == stmt)
+            ? static_cast<StatementTiming*>(lastExecuted.timing) : timingOf(stmt);
+        if (timing) ++timing->rows;
+    }
+    return status;
+}
+
+MYSQL_RES* DatabaseManager::runQuery(const std::string& sql, const char* label, bool& ok) {
+    ok = false;
+    MYSQL* handle = getConnection();
+    if (!handle) {
+        return nullptr;
+    }
+    QueryLog::Entry* entry = queryLog.entry(label ? std::string(label) : sql);
+
+    auto start = std::chrono::steady_clock::now();
+    ok = mysql_real_query(handle, sql.data(), (unsigned long)sql.size()) == 0;
+    MYSQL_RES* result = nullptr;
+    bool hasResult = ok && mysql_field_count(handle) > 0;
+    if (hasResult) {
+        result = mysql_store_result(handle);
+        ok = result != nullptr;
+    }
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+    uint64_t rows = 0;
+    if (result) {
+        rows = (uint64_t)mysql_num_rows(result);
+    }
+    else if (ok) {
+        rows = (uint64_t)mysql_affected_rows(handle);
+    }
+
+    queryLog.record(entry, elapsed, rows, 1, ok);
+    if (queryLog.isSlow(elapsed)) {
+        queryLog.logSlow(entry, elapsed, rows);
+    }
+    return result;
+}
+
+bool DatabaseManager::query(const std::string& sql, const char* label) {
+    bool ok;
+    MYSQL_RES* result = runQuery(sql, label, ok);
+    if (result) mysql_free_result(result);
+    return ok;
+}
+
+MYSQL_RES* DatabaseManager::queryResult(const std::string& sql, const char* label) {
+    bool ok;
+    return runQuery(sql, label, ok);
+}
+
+void DatabaseManager::setSlowQueryLog(const std::string& path, std::chrono::milliseconds threshold) {
+    queryLog.setSlowQueryLog(path, threshold);
+}
+
+DatabaseManager::Lease DatabaseManager::acquire(std::chrono::milliseconds timeout) {
+    if (!conn) {
+        std::cerr << "Database is not connected\n";
+        return Lease();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + timeout;
+    bool waited = false;
+    bool grow = false;
+    Pooled pooled = { nullptr, start };
+
+    {
+        std::unique_lock<std::mutex> lock(poolLock);
+        while (idle.empty() && openCount >= maxSize) {
+            waited = true;
+            if (poolReady.wait_until(lock, deadline) == std::cv_status::timeout
+                && idle.empty() && openCount >= maxSize) {
+                ++stats.timeouts;
+                lock.unlock();
+                std::cerr << "Timed out waiting for a database connection\n";
+                return Lease();
+            }
+        }
+
+        if (!idle.empty()) {
+            pooled = idle.back(); // most recently used: least likely to be stale
+            idle.pop_back();
+        }
+        else {
+            // Reserve the slot before the lock is dropped for the connect
+            grow = true;
+            ++openCount;
+        }
+        stats.inUse = openCount - idle.size();
+        stats.peakInUse = (std::max)(stats.peakInUse, stats.inUse);
+    }
+
+    clientThread.ensure();
+
+    bool reconnected = false;
+    if (grow) {
+        pooled.conn = openConnection();
+    }
+    else if (std::chrono::steady_clock::now() - pooled.lastUsed >= validateAfter
+        && mysql_ping(pooled.conn) != 0) {
+        // Dropped by the server (wait_timeout, restart); replace it
+        closeConnection(pooled.conn);
+        pooled.conn = openConnection();
+        reconnected = true;
+    }
+
+    double waitMs = millisecondsSince(start);
+    std::lock_guard<std::mutex> guard(poolLock);
+    if (!pooled.conn) {
+        --openCount;
+        stats.size = openCount;
+        stats.inUse = openCount - idle.size();
+        poolReady.notify_one();
+        return Lease();
+    }
+
+    ++stats.acquisitions;
+    if (waited) ++stats.waits;
+    if (reconnected) ++stats.reconnects;
+    stats.totalWaitMs += waitMs;
+    stats.maxWaitMs = (std::max)(stats.maxWaitMs, waitMs);
+    stats.size = openCount;
+    stats.idle = idle.size();
+    return Lease(this, pooled.conn);
+}
+
+void DatabaseManager::giveBack(MYSQL* handle) {
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        idle.push_back({ handle, std::chrono::steady_clock::now() });
+        stats.idle = idle.size();
+        stats.inUse = openCount - idle.size();
+    }
+    poolReady.notify_one();
+}
+
+DatabaseManager::PoolStats DatabaseManager::poolStats() const {
+    PoolStats snapshot;
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        snapshot = stats;
+    }
+    std::lock_guard<std::mutex> guard(statementLock);
+    snapshot.statementPrepares = statementPrepares;
+    snapshot.statementReuses = statementReuses;
+    return snapshot;
+}
+
+void DatabaseManager::displayPoolStats() const {
+    PoolStats s = poolStats();
+
+    std::cout << "\n--- Database Pool Statistics ---\n";
+    std::cout << "Pool Limits: " << minSize << " - " << maxSize << " connections\n";
+    std::cout << "Open: " << s.size << " (idle " << s.idle << ", in use " << s.inUse
+        << ", peak " << s.peakInUse << ")\n";
+    std::cout << "Acquisitions: " << s.acquisitions << " (" << s.waits << " waited, "
+        << s.timeouts << " timed out)\n";
+    std::cout << "Reconnects: " << s.reconnects << "\n";
+    std::cout << "Prepared Statements: " << s.statementPrepares << " prepared, "
+        << s.statementReuses << " reused\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Average Wait: " << (s.acquisitions > 0 ? s.totalWaitMs / s.acquisitions : 0.0) << " ms\n";
+    std::cout << "Longest Wait: " << s.maxWaitMs << " ms\n";
+}
@@ -0,0 +1,253 @@
+#include "Drive_Cycle.h"
+#include "Batch_Lanes.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+    using namespace BatchLanes;
+
+    struct StepTerms {
+        double invDt;
+        double massKg;
+        double slopeForce;
+        double aeroFactor;
+        double auxPowerW;
+        double invRatedPowerW;
+    };
+
+    struct StepSums {
+        double powerOverEff = 0.0;
+        double speedSum = 0.0;
+        double maxAccel = 0.0;
+    };
+
+    // Steps (kmh[j-1], kmh[j]) from j in strides of L::WIDTH; returns the
+    // first j left unprocessed
+    template <typename L>
+    size_t stepKernel(const double* kmh, size_t count, size_t j, const StepTerms& t, StepSums& sums) {
+        using V = typename L::Vec;
+
+        const V zero = L::set1(0.0);
+        const V half = L::set1(0.5);
+        const V toMs = L::set1(1.0 / 3.6);
+        const V invDt = L::set1(t.invDt);
+        const V mass = L::set1(t.massKg);
+        const V slope = L::set1(t.slopeForce);
+        const V aero = L::set1(t.aeroFactor);
+        const V aux = L::set1(t.auxPowerW);
+        const V invDrivetrain = L::set1(1.0 / 0.85);
+        const V invRated = L::set1(t.invRatedPowerW);
+
+        V fuel = zero;
+        V speed = zero;
+        V peak = zero;
+
+        for (; j + L::WIDTH <= count; j += L::WIDTH) {
+            V v0 = L::load(kmh + j - 1) * toMs;
+            V v1 = L::load(kmh + j) * toMs;
+            V v = (v0 + v1) * half;
+            V a = (v1 - v0) * invDt;
+
+            V F_total = slope + aero * (v * v) + mass * a;
+            V P_wheels = L::max(zero, F_total * v);
+            V P_required = P_wheels * invDrivetrain + aux;
+            V efficiency = L::efficiency(P_required * invRated);
+
+            fuel = fuel + P_required / efficiency;
+            speed = speed + v;
+            peak = L::max(peak, a);
+        }
+
+        double lanes[3][L::WIDTH];
+        L::store(lanes[0], fuel);
+        L::store(lanes[1], speed);
+        L::store(lanes[2], peak);
+        for (size_t k = 0; k < L::WIDTH; ++k) {
+            sums.powerOverEff += lanes[0][k];
+            sums.speedSum += lanes[1][k];
+            sums.maxAccel = (std::max)(sums.maxAccel, lanes[2][k]);
+        }
+        return j;
+    }
+
+    // Trims spaces, tabs and carriage returns from both ends of [begin, end)
+    void trim(const char*& begin, const char*& end) {
+        while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) ++begin;
+        while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    }
+
+}
+
+DriveCycle::DriveCycle(const Vehicle& vehicle, const Environment& environment, double sampleIntervalSec)
+    : dt(sampleIntervalSec), invDt(1.0 / sampleIntervalSec), massKg(vehicle.massKg) {
+    VehicleCoefficients c = vehicle.currentCoefficients();
+
+    // cos(atan(g)) and sin(atan(g)) without the trig calls
+    double invHyp = 1.0 / std::sqrt(1.0 + environment.roadGradient * environment.roadGradient);
+    slopeForce = environment.surfaceRoughness * c.rollFactor * invHyp + c.weightN * environment.roadGradient * invHyp;
+
+    double rho = Environment::airDensity(environment.ambientTempC, environment.pressurePa);
+    aeroFactor = c.aeroFactor * rho;
+
+    auxPowerW = 300.0;
+    if (vehicle.hasAC && environment.ambientTempC > 20.0) {
+        auxPowerW += 4000.0;
+    }
+    invRatedPowerW = 1.0 / c.ratedPowerW;
+
+    reset();
+}
+
+void DriveCycle::reset() {
+    havePrevious = false;
+    previousKmh = 0.0;
+    sampleCount = 0;
+    powerOverEff = 0.0;
+    speedSum = 0.0;
+    maxAccel = 0.0;
+}
+
+void DriveCycle::integrate(const double* speedKmh, size_t count) {
+    StepTerms terms = { invDt, massKg, slopeForce, aeroFactor, auxPowerW, invRatedPowerW };
+    StepSums sums;
+    sums.maxAccel = maxAccel;
+
+    size_t j = 1;
+#if defined(__AVX2__)
+    j = stepKernel<AvxDoubleLanes>(speedKmh, count, j, terms, sums);
+#endif
+    stepKernel<ScalarLanes<double>>(speedKmh, count, j, terms, sums);
+
+    powerOverEff += sums.powerOverEff;
+    speedSum += sums.speedSum;
+    maxAccel = sums.maxAccel;
+}
+
+void DriveCycle::addSamples(const double* speedKmh, size_t count) {
+    if (count == 0) return;
+
+    // Step across the boundary with the previous block
+    if (havePrevious) {
+        double pair[2] = { previousKmh, speedKmh[0] };
+        integrate(pair, 2);
+    }
+    integrate(speedKmh, count);
+
+    havePrevious = true;
+    previousKmh = speedKmh[count - 1];
+    sampleCount += count;
+}
+
+bool DriveCycle::addFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open drive cycle file: " << filename << "\n";
+        return false;
+    }
+
+    // Fixed buffers: raw text and parsed samples
+    const size_t READ_SIZE = 1 << 16;
+    const size_t BLOCK_SIZE = 4096;
+    std::vector<char> text(READ_SIZE);
+    std::vector<double> block(BLOCK_SIZE);
+    size_t pending = 0;
+
+    size_t startCount = sampleCount;
+    size_t carry = 0;
+    size_t lineNo = 0;
+    bool eof = false;
+
+    while (!eof) {
+        file.read(text.data() + carry, static_cast<std::streamsize>(READ_SIZE - carry));
+        size_t filled = carry + static_cast<size_t>(file.gcount());
+        eof = !file;
+
+        size_t lineStart = 0;
+        while (lineStart < filled) {
+            const char* base = text.data();
+            const char* newline = static_cast<const char*>(std::memchr(base + lineStart, '\n', filled - lineStart));
+            if (!newline && !eof) break; // partial line, completed by the next read
+
+            size_t lineEnd = newline ? static_cast<size_t>(newline - base) : filled;
+            ++lineNo;
+
+            const char* begin = base + lineStart;
+            const char* end = base + lineEnd;
+            lineStart = lineEnd + 1;
+
+            trim(begin, end);
+            if (begin == end || *begin == '#') continue;
+
+            // Speed is the last column
+            const char* field = end;
+            while (field > begin && field[-1] != ',') --field;
+            trim(field, end);
+
+            double value = 0.0;
+            std::from_chars_result parsed = std::from_chars(field, end, value);
+            if (parsed.ec != std::errc() || parsed.ptr != end || value < 0.0) {
+                // Skip a header row such as "time_s,speed_kmh"
+                if (sampleCount == startCount && pending == 0 && std::isalpha(static_cast<unsigned char>(*begin))) continue;
+
+                std::cerr << "Invalid speed sample at line " << lineNo << " of " << filename << "\n";
+                reset();
+                return false;
+            }
+
+            block[pending++] = value;
+            if (pending == BLOCK_SIZE) {
+                addSamples(block.data(), pending);
+                pending = 0;
+            }
+        }
+
+        carry = lineStart < filled ? filled - lineStart : 0;
+        if (carry == READ_SIZE) {
+            std::cerr << "Line " << lineNo + 1 << " of " << filename << " is too long\n";
+            reset();
+            return false;
+        }
+        std::memmove(text.data(), text.data() + filled - carry, carry);
+    }
+
+    addSamples(block.data(), pending);
+
+    if (sampleCount == startCount) {
+        std::cerr << "Drive cycle file contains no samples: " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+DriveCycleResult DriveCycle::result() const {
+    DriveCycleResult r;
+    size_t steps = sampleCount > 0 ? sampleCount - 1 : 0;
+
+    r.samples = sampleCount;
+    r.durationSec = static_cast<double>(steps) * dt;
+    r.distanceKm = speedSum * dt / 1000.0;
+    r.liters = powerOverEff * dt / 43000000.0 / 0.832;
+    r.maxAccelMs2 = maxAccel;
+    return r;
+}
+
+void DriveCycle::displayResult(const DriveCycleResult& r) const {
+    std::cout << "\n--- Drive Cycle Report ---\n";
+    std::cout << "Samples: " << r.samples << "\n";
+    std::cout << "Duration: " << std::fixed << std::setprecision(1) << r.durationSec / 60.0 << " min\n";
+    std::cout << "Distance: " << std::setprecision(3) << r.distanceKm << " km\n";
+    std::cout << "Average Speed: " << std::setprecision(1) << r.averageSpeedKmh() << " km/h\n";
+    std::cout << "Peak Acceleration: " << std::setprecision(2) << r.maxAccelMs2 << " m/s^2\n";
+    std::cout << "Fuel Consumed: " << std::setprecision(3) << r.liters << " L";
+    if (r.distanceKm > 0.0) {
+        std::cout << " (" << std::setprecision(2) << r.liters / r.distanceKm * 100.0 << " L/100km)";
+    }
+    std::cout << "\n";
+}
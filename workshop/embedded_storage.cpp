@@ -0,0 +1,824 @@
+#include "Embedded_Storage.h"
+#include "Environment.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    const char* VEHICLES = "vehicles.tsv";
+    const char* PRESETS = "presets.tsv";
+    const char* ENVIRONMENTS = "environment_presets.tsv";
+    const char* FUEL_PRICE = "fuel_price.tsv";
+    const char* USERS = "users.tsv";
+    const char* HISTORY = "calculation_history.tsv";
+
+    // Records copied out per lock hold while scanning, so a long export does
+    // not stall the history writer
+    const size_t SCAN_CHUNK = 1024;
+
+    // Fields are tab-separated; tabs, newlines and backslashes inside a field
+    // are escaped
+    void appendField(std::string& line, const std::string& value) {
+        if (!line.empty()) line += '\t';
+        for (char c : value) {
+            switch (c) {
+            case '\\': line += "\\\\"; break;
+            case '\t': line += "\\t"; break;
+            case '\n': line += "\\n"; break;
+            case '\r': line += "\\r"; break;
+            default: line += c; break;
+            }
+        }
+    }
+
+    // Shortest representation that reads back to the same double
+    void appendField(std::string& line, double value) {
+        if (!line.empty()) line += '\t';
+        char buffer[32];
+        std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        line.append(buffer, r.ptr);
+    }
+
+    void appendField(std::string& line, int value) {
+        if (!line.empty()) line += '\t';
+        char buffer[16];
+        std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        line.append(buffer, r.ptr);
+    }
+
+    std::vector<std::string> splitFields(const std::string& line) {
+        std::vector<std::string> fields(1);
+        for (size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (c == '\t') {
+                fields.emplace_back();
+            }
+            else if (c == '\\' && i + 1 < line.size()) {
+                char next = line[++i];
+                fields.back() += next == 't' ? '\t' : next == 'n' ? '\n' : next == 'r' ? '\r' : next;
+            }
+            else if (c != '\r') {
+                fields.back() += c;
+            }
+        }
+        return fields;
+    }
+
+    double toDouble(const std::string& field) {
+        double value = 0.0;
+        std::from_chars(field.data(), field.data() + field.size(), value);
+        return value;
+    }
+
+    int toInt(const std::string& field) {
+        int value = 0;
+        std::from_chars(field.data(), field.data() + field.size(), value);
+        return value;
+    }
+
+    // Lines of a table file, or none if it does not exist yet
+    std::vector<std::vector<std::string>> readTable(const std::string& path, size_t columns) {
+        std::vector<std::vector<std::string>> rows;
+        std::ifstream file(path, std::ios::binary);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::vector<std::string> fields = splitFields(line);
+            if (fields.size() < columns) {
+                std::cerr << "Skipping malformed line in " << path << "\n";
+                continue;
+            }
+            rows.push_back(std::move(fields));
+        }
+        return rows;
+    }
+
+    std::string vehicleLine(const Vehicle& v) {
+        std::string line;
+        appendField(line, v.vehicle_id);
+        appendField(line, v.model_name);
+        appendField(line, v.efficiency);
+        appendField(line, v.massKg);
+        appendField(line, v.dragCoef);
+        appendField(line, v.frontalArea);
+        appendField(line, v.engineRatedPower);
+        appendField(line, v.tirePressureBar);
+        appendField(line, v.hasAC ? 1 : 0);
+        return line;
+    }
+
+    std::string recordLine(const CalculationRecord& r) {
+        std::string line;
+        appendField(line, r.id);
+        appendField(line, r.username);
+        appendField(line, r.vehicle_id);
+        appendField(line, r.mission_name);
+        const double values[] = { r.vehicle_mass, r.vehicle_drag_coef, r.vehicle_frontal_area,
+            r.vehicle_tire_pressure, r.vehicle_engine_power };
+        for (double value : values) appendField(line, value);
+        appendField(line, r.vehicle_has_ac ? 1 : 0);
+        const double more[] = { r.vehicle_efficiency, r.road_gradient, r.surface_roughness,
+            r.ambient_temp, r.pressure, r.distance_km, r.avg_speed_kmh,
+            r.fuel_consumed_liters, r.cost_per_km };
+        for (double value : more) appendField(line, value);
+        appendField(line, r.calculated_at);
+        return line;
+    }
+
+    // Same column order as calculation_history and recordLine
+    CalculationRecord recordFromFields(const std::vector<std::string>& f) {
+        CalculationRecord r = {};
+        r.id = toInt(f[0]);
+        r.username = f[1];
+        r.vehicle_id = f[2];
+        r.mission_name = f[3];
+        double* before[] = { &r.vehicle_mass, &r.vehicle_drag_coef, &r.vehicle_frontal_area,
+            &r.vehicle_tire_pressure, &r.vehicle_engine_power };
+        for (int k = 0; k < 5; ++k) *before[k] = toDouble(f[4 + k]);
+        r.vehicle_has_ac = toInt(f[9]) == 1;
+        double* after[] = { &r.vehicle_efficiency, &r.road_gradient, &r.surface_roughness,
+            &r.ambient_temp, &r.pressure, &r.distance_km, &r.avg_speed_kmh,
+            &r.fuel_consumed_liters, &r.cost_per_km };
+        for (int k = 0; k < 9; ++k) *after[k] = toDouble(f[10 + k]);
+        r.calculated_at = f[19];
+        return r;
+    }
+
+    bool keyBefore(const CalculationRecord& a, const std::string& time, int id) {
+        int order = a.calculated_at.compare(time);
+        return order < 0 || (order == 0 && a.id < id);
+    }
+
+    void copyAttributes(const Vehicle& from, Vehicle& to) {
+        to.vehicle_id = from.vehicle_id;
+        to.model_name = from.model_name;
+        to.efficiency = from.efficiency;
+        to.massKg = from.massKg;
+        to.dragCoef = from.dragCoef;
+        to.frontalArea = from.frontalArea;
+        to.engineRatedPower = from.engineRatedPower;
+        to.tirePressureBar = from.tirePressureBar;
+        to.hasAC = from.hasAC;
+    }
+
+}
+
+EmbeddedStorage::EmbeddedStorage(const std::string& directory)
+    : directory(directory), hasFuelPrice(false), fuelPrice(0.0), nextCalculationId(1) {}
+
+std::string EmbeddedStorage::pathOf(const char* table) const {
+    return (fs::path(directory) / table).string();
+}
+
+bool EmbeddedStorage::open() {
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Cannot create data directory " << directory << ": " << error.message() << "\n";
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    if (!loadTables()) {
+        return false;
+    }
+
+    historyLog.open(pathOf(HISTORY), std::ios::binary | std::ios::app);
+    if (!historyLog.is_open()) {
+        std::cerr << "Cannot open " << pathOf(HISTORY) << " for writing\n";
+        return false;
+    }
+
+    std::cout << "Opened embedded store: " << directory << " (" << vehicles.size() << " vehicles, "
+        << users.size() << " users, " << history.size() << " calculations)" << std::endl;
+    return true;
+}
+
+bool EmbeddedStorage::loadTables() {
+    for (const std::vector<std::string>& f : readTable(pathOf(VEHICLES), 9)) {
+        Vehicle v(this);
+        v.vehicle_id = f[0];
+        v.model_name = f[1];
+        v.efficiency = toDouble(f[2]);
+        v.massKg = toDouble(f[3]);
+        v.dragCoef = toDouble(f[4]);
+        v.frontalArea = toDouble(f[5]);
+        v.engineRatedPower = toDouble(f[6]);
+        v.tirePressureBar = toDouble(f[7]);
+        v.hasAC = toInt(f[8]) == 1;
+        vehicles.emplace(v.vehicle_id, v);
+    }
+
+    for (const std::vector<std::string>& f : readTable(pathOf(PRESETS), 4)) {
+        MissionPreset preset;
+        preset.name = f[0];
+        preset.roadGradient = toDouble(f[1]);
+        preset.surfaceRoughness = toDouble(f[2]);
+        preset.ambientTempC = toDouble(f[3]);
+        presets[preset.name] = preset;
+    }
+
+    for (const std::vector<std::string>& f : readTable(pathOf(ENVIRONMENTS), 6)) {
+        environments.push_back({ f[0], f[1], toDouble(f[2]), toDouble(f[3]), toDouble(f[4]), toDouble(f[5]) });
+    }
+
+    for (const std::vector<std::string>& f : readTable(pathOf(USERS), 3)) {
+        users[f[0]] = { f[0], f[1], f[2] };
+    }
+
+    std::vector<std::vector<std::string>> price = readTable(pathOf(FUEL_PRICE), 1);
+    if (!price.empty()) {
+        hasFuelPrice = true;
+        fuelPrice = toDouble(price.back()[0]);
+    }
+
+    for (const std::vector<std::string>& f : readTable(pathOf(HISTORY), 20)) {
+        history.push_back(recordFromFields(f));
+    }
+    std::sort(history.begin(), history.end(), [](const CalculationRecord& a, const CalculationRecord& b) {
+        return keyBefore(a, b.calculated_at, b.id);
+    });
+    for (const CalculationRecord& r : history) {
+        nextCalculationId = (std::max)(nextCalculationId, r.id + 1);
+    }
+    indexHistory();
+    return true;
+}
+
+void EmbeddedStorage::indexHistory() {
+    historyByUser.clear();
+    for (size_t i = 0; i < history.size(); ++i) {
+        historyByUser[history[i].username].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+bool EmbeddedStorage::replaceFile(const char* table, const std::string& contents) {
+    std::string path = pathOf(table);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.flush();
+        if (!file) {
+            std::cerr << "Failed to write " << temporary << "\n";
+            return false;
+        }
+    }
+
+    // rename() replaces the old file in one step, so a crash leaves either
+    // the old table or the new one
+    std::error_code error;
+    fs::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to replace " << path << ": " << error.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool EmbeddedStorage::saveVehicles() {
+    std::string contents;
+    for (const auto& entry : vehicles) {
+        contents += vehicleLine(entry.second);
+        contents += '\n';
+    }
+    return replaceFile(VEHICLES, contents);
+}
+
+bool EmbeddedStorage::savePresets() {
+    std::string contents;
+    for (const auto& entry : presets) {
+        std::string line;
+        appendField(line, entry.second.name);
+        appendField(line, entry.second.roadGradient);
+        appendField(line, entry.second.surfaceRoughness);
+        appendField(line, entry.second.ambientTempC);
+        contents += line;
+        contents += '\n';
+    }
+    return replaceFile(PRESETS, contents);
+}
+
+bool EmbeddedStorage::saveUsers() {
+    std::string contents;
+    for (const auto& entry : users) {
+        std::string line;
+        appendField(line, entry.second.username);
+        appendField(line, entry.second.passwordHash);
+        appendField(line, entry.second.role);
+        contents += line;
+        contents += '\n';
+    }
+    return replaceFile(USERS, contents);
+}
+
+bool EmbeddedStorage::writeFuelPrice() {
+    std::string line;
+    appendField(line, fuelPrice);
+    return replaceFile(FUEL_PRICE, line + "\n");
+}
+
+bool EmbeddedStorage::saveHistory() {
+    historyLog.close();
+    std::string contents;
+    for (const CalculationRecord& r : history) {
+        contents += recordLine(r);
+        contents += '\n';
+    }
+    bool saved = replaceFile(HISTORY, contents);
+    historyLog.open(pathOf(HISTORY), std::ios::binary | std::ios::app);
+    return saved && historyLog.is_open();
+}
+
+// VEHICLES
+
+bool EmbeddedStorage::vehicleExists(const std::string& id) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return vehicles.count(id) > 0;
+}
+
+bool EmbeddedStorage::loadVehicle(const std::string& id, Vehicle& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    auto it = vehicles.find(id);
+    if (it == vehicles.end()) {
+        return false;
+    }
+    copyAttributes(it->second, out);
+    return true;
+}
+
+bool EmbeddedStorage::loadAllVehicles(std::vector<Vehicle>& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    out.clear();
+    out.reserve(vehicles.size());
+    for (const auto& entry : vehicles) {
+        out.push_back(entry.second);
+    }
+    return true;
+}
+
+int EmbeddedStorage::insertVehicle(const Vehicle& vehicle) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    if (vehicles.count(vehicle.vehicle_id) > 0) {
+        return 0;
+    }
+
+    Vehicle stored(this);
+    copyAttributes(vehicle, stored);
+    vehicles.emplace(stored.vehicle_id, stored);
+    if (!saveVehicles()) {
+        vehicles.erase(stored.vehicle_id);
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::updateVehicle(const Vehicle& changes) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = vehicles.find(changes.vehicle_id);
+    if (it == vehicles.end()) {
+        return 0;
+    }
+
+    Vehicle previous = it->second;
+    it->second.applyChanges(changes);
+    if (!saveVehicles()) {
+        it->second = previous;
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::deleteVehicle(const std::string& id) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = vehicles.find(id);
+    if (it == vehicles.end()) {
+        return 0;
+    }
+
+    Vehicle previous = it->second;
+    vehicles.erase(it);
+    if (!saveVehicles()) {
+        vehicles.emplace(id, previous);
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::upsertVehicles(const std::vector<Vehicle>& batch) {
+    if (batch.empty()) return 0;
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+
+    // Rows the batch replaced or added, newest last, to undo a failed save
+    std::vector<std::pair<Vehicle, bool>> previous;   // (old row, existed)
+    previous.reserve(batch.size());
+    for (const Vehicle& vehicle : batch) {
+        auto it = vehicles.find(vehicle.vehicle_id);
+        if (it != vehicles.end()) {
+            previous.emplace_back(it->second, true);
+        }
+        else {
+            it = vehicles.emplace(vehicle.vehicle_id, Vehicle(this)).first;
+            previous.emplace_back(vehicle, false);
+        }
+        copyAttributes(vehicle, it->second);
+    }
+
+    // One rewrite of the table for the whole batch
+    if (!saveVehicles()) {
+        for (auto undo = previous.rbegin(); undo != previous.rend(); ++undo) {
+            if (undo->second) {
+                copyAttributes(undo->first, vehicles.at(undo->first.vehicle_id));
+            }
+            else {
+                vehicles.erase(undo->first.vehicle_id);
+            }
+        }
+        return -1;
+    }
+    return (int)batch.size();
+}
+
+// MISSION PRESETS
+
+bool EmbeddedStorage::savePreset(const MissionPreset& preset) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    presets[preset.name] = preset;
+    return savePresets();
+}
+
+int EmbeddedStorage::loadPreset(const std::string& name, MissionPreset& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    auto it = presets.find(name);
+    if (it == presets.end()) {
+        return 0;
+    }
+    out = it->second;
+    return 1;
+}
+
+bool EmbeddedStorage::listPresets(std::vector<MissionPreset>& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    out.clear();
+    for (const auto& entry : presets) {
+        out.push_back(entry.second);
+    }
+    return true;
+}
+
+int EmbeddedStorage::deletePreset(const std::string& name) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    if (presets.erase(name) == 0) {
+        return 0;
+    }
+    return savePresets() ? 1 : -1;
+}
+
+// ENVIRONMENT PRESETS
+
+bool EmbeddedStorage::findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    for (const EnvironmentPreset& preset : environments) {
+        if (preset.terrain == terrain || preset.climate == climate) {
+            out.roadGradient = preset.gradient;
+            out.surfaceRoughness = preset.roughness;
+            out.ambientTempC = preset.temperature;
+            out.pressurePa = preset.pressure;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EmbeddedStorage::listEnvironments(std::vector<EnvironmentPreset>& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    out = environments;
+    return true;
+}
+
+// FUEL PRICE
+
+bool EmbeddedStorage::loadFuelPrice(double& price) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    if (!hasFuelPrice) {
+        return false;
+    }
+    price = fuelPrice;
+    return true;
+}
+
+bool EmbeddedStorage::saveFuelPrice(double price) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    hasFuelPrice = true;
+    fuelPrice = price;
+    return writeFuelPrice();
+}
+
+// USERS
+
+bool EmbeddedStorage::findUser(const std::string& username, UserAccount& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return false;
+    }
+    out = it->second;
+    return true;
+}
+
+std::vector<UserAccount> EmbeddedStorage::listUsers() {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::vector<UserAccount> all;
+    for (const auto& entry : users) {
+        UserAccount user = entry.second;
+        user.passwordHash.clear();
+        all.push_back(user);
+    }
+    return all;
+}
+
+int EmbeddedStorage::countUsers() {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return static_cast<int>(users.size());
+}
+
+int EmbeddedStorage::insertUser(const UserAccount& user) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    if (!users.emplace(user.username, user).second) {
+        return 0;
+    }
+    if (!saveUsers()) {
+        users.erase(user.username);
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::updatePasswordHash(const std::string& username, const std::string& passwordHash) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return 0;
+    }
+    std::string previous = it->second.passwordHash;
+    it->second.passwordHash = passwordHash;
+    if (!saveUsers()) {
+        it->second.passwordHash = previous;
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::updateRole(const std::string& username, const std::string& role) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return 0;
+    }
+    std::string previous = it->second.role;
+    it->second.role = role;
+    if (!saveUsers()) {
+        it->second.role = previous;
+        return -1;
+    }
+    return 1;
+}
+
+int EmbeddedStorage::deleteUser(const std::string& username) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return 0;
+    }
+    UserAccount previous = it->second;
+    users.erase(it);
+    if (!saveUsers()) {
+        users.emplace(username, previous);
+        return -1;
+    }
+    return 1;
+}
+
+// CALCULATION HISTORY
+
+bool EmbeddedStorage::appendCalculations(const std::vector<CalculationRecord>& records) {
+    if (records.empty()) return true;
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+
+    // Records keep the time they were stamped with, but never go earlier
+    // than the newest record (clock steps back, or a write-behind queue),
+    // so the history stays in key order without re-sorting
+    std::string now = CalculationRecord::currentTimestamp();
+
+    std::string lines;
+    size_t first = history.size();
+    for (const CalculationRecord& record : records) {
+        std::string stamp = record.calculated_at.empty() ? now : record.calculated_at;
+        if (!history.empty() && stamp < history.back().calculated_at) {
+            stamp = history.back().calculated_at;
+        }
+
+        history.push_back(record);
+        CalculationRecord& stored = history.back();
+        stored.id = nextCalculationId++;
+        stored.calculated_at = stamp;
+        historyByUser[stored.username].push_back(static_cast<uint32_t>(history.size() - 1));
+        lines += recordLine(stored);
+        lines += '\n';
+    }
+
+    historyLog.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    historyLog.flush();
+    if (!historyLog) {
+        std::cerr << "Failed to append to " << pathOf(HISTORY) << "\n";
+        historyLog.clear();
+        history.resize(first);
+        nextCalculationId = history.empty() ? 1 : history.back().id + 1;
+        indexHistory();
+        return false;
+    }
+    return true;
+}
+
+std::vector<CalculationRecord> EmbeddedStorage::queryCalculations(const CalculationQuery& query) {
+    std::vector<CalculationRecord> records;
+    if (query.limit <= 0) {
+        return records;
+    }
+
+    std::shared_lock<std::shared_mutex> guard(lock);
+
+    // The rows in listing key order: one user's index, or the whole history
+    const std::vector<uint32_t>* positions = nullptr;
+    size_t count = history.size();
+    if (!query.username.empty()) {
+        auto found = historyByUser.find(query.username);
+        if (found == historyByUser.end()) {
+            return records;
+        }
+        positions = &found->second;
+        count = positions->size();
+    }
+    auto row = [&](size_t k) -> const CalculationRecord& {
+        return positions ? history[(*positions)[k]] : history[k];
+    };
+    auto matches = [&](const CalculationRecord& r) {
+        return (query.vehicleId.empty() || r.vehicle_id == query.vehicleId)
+            && (query.fromDate.empty() || r.calculated_at >= query.fromDate)
+            && (query.toDate.empty() || r.calculated_at <= query.toDate);
+    };
+
+    // Binary search to the cursor, then walk away from it; the cost is the
+    // page (plus rows skipped by vehicle/date filters), not the depth
+    size_t low = 0;
+    size_t high = count;
+    if (query.hasCursor) {
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (keyBefore(row(mid), query.cursorTime, query.cursorId)) low = mid + 1;
+            else high = mid;
+        }
+        // low is now the first row at or after the cursor
+    }
+
+    if (query.newer) {
+        // Oldest first, strictly after the cursor
+        size_t k = low;
+        if (query.hasCursor && k < count && row(k).id == query.cursorId
+            && row(k).calculated_at == query.cursorTime) {
+            ++k;
+        }
+        else if (!query.hasCursor) {
+            k = 0;
+        }
+        for (; k < count && (int)records.size() < query.limit; ++k) {
+            if (matches(row(k))) records.push_back(row(k));
+        }
+    }
+    else {
+        // Newest first, strictly before the cursor
+        size_t k = query.hasCursor ? low : count;
+        while (k > 0 && (int)records.size() < query.limit) {
+            --k;
+            if (matches(row(k))) records.push_back(row(k));
+        }
+    }
+    return records;
+}
+
+bool EmbeddedStorage::getCalculation(int id, CalculationRecord& out) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    auto it = std::lower_bound(history.begin(), history.end(), id,
+        [](const CalculationRecord& r, int value) { return r.id < value; });
+    if (it == history.end() || it->id != id) {
+        return false;
+    }
+    out = *it;
+    return true;
+}
+
+int EmbeddedStorage::deleteCalculation(int id, const std::string& owner) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto it = std::lower_bound(history.begin(), history.end(), id,
+        [](const CalculationRecord& r, int value) { return r.id < value; });
+    if (it == history.end() || it->id != id || (!owner.empty() && it->username != owner)) {
+        return 0;
+    }
+    history.erase(it);
+    indexHistory();
+    return saveHistory() ? 1 : -1;
+}
+
+int EmbeddedStorage::deleteUserCalculations(const std::string& username) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    size_t before = history.size();
+    history.erase(std::remove_if(history.begin(), history.end(),
+        [&](const CalculationRecord& r) { return r.username == username; }), history.end());
+    int removed = static_cast<int>(before - history.size());
+    if (removed == 0) {
+        return 0;
+    }
+    indexHistory();
+    return saveHistory() ? removed : -1;
+}
+
+CalculationTotals EmbeddedStorage::calculationTotals(const std::string& username) {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    CalculationTotals totals;
+    if (username.empty()) {
+        for (const CalculationRecord& r : history) totals.totalFuel += r.fuel_consumed_liters;
+        totals.count = static_cast<int>(history.size());
+    }
+    else {
+        auto it = historyByUser.find(username);
+        if (it != historyByUser.end()) {
+            for (uint32_t p : it->second) totals.totalFuel += history[p].fuel_consumed_liters;
+            totals.count = static_cast<int>(it->second.size());
+        }
+    }
+    if (totals.count > 0) {
+        totals.averageFuel = totals.totalFuel / totals.count;
+    }
+    return totals;
+}
+
+std::vector<std::string> EmbeddedStorage::calculationUsers() {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::vector<std::string> names;
+    for (const auto& entry : historyByUser) {
+        if (!entry.second.empty()) names.push_back(entry.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool EmbeddedStorage::scanCalculations(const std::string& username,
+    const std::function<void(const CalculationRecord&)>& visit) {
+    std::vector<CalculationRecord> chunk;
+    int nextId = 0;
+
+    for (;;) {
+        chunk.clear();
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            auto it = std::lower_bound(history.begin(), history.end(), nextId,
+                [](const CalculationRecord& r, int value) { return r.id < value; });
+            for (; it != history.end() && chunk.size() < SCAN_CHUNK; ++it) {
+                if (username.empty() || it->username == username) chunk.push_back(*it);
+            }
+        }
+        if (chunk.empty()) {
+            return true;
+        }
+
+        for (const CalculationRecord& record : chunk) {
+            visit(record);
+        }
+        if (chunk.size() < SCAN_CHUNK) {
+            return true;
+        }
+        nextId = (std::max)(nextId, chunk.back().id + 1);
+    }
+}
+
+size_t EmbeddedStorage::maxConcurrency() const {
+    return (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+void EmbeddedStorage::displayStats() const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::cout << "\n--- Embedded Store ---\n";
+    std::cout << "Directory: " << directory << "\n";
+    std::cout << "Vehicles: " << vehicles.size() << " | Presets: " << presets.size()
+        << " | Environment Presets: " << environments.size() << "\n";
+    std::cout << "Users: " << users.size() << " | Calculations: " << history.size() << "\n";
+}
@@ -0,0 +1,22 @@
+#include "Environment.h"
+
+// Database-independent parts of Environment; loadEnvironment stays in
+// environment.cpp.
+
+// default
+void Environment::setRawEnvironment(double grad, double rough, double temp) {
+    this->roadGradient = grad;
+    this->surfaceRoughness = rough;
+    this->ambientTempC = temp;
+    this->pressurePa = 101325.0;
+}
+
+double Environment::getAirDensity() const {
+    return airDensity(this->ambientTempC, this->pressurePa);
+}
+
+double Environment::airDensity(double tempC, double pressurePa) {
+    const double R_specific = 287.058;
+    double T_kelvin = tempC + 273.15;
+    return pressurePa / (R_specific * T_kelvin);
+}
@@ -0,0 +1,216 @@
+#include "History_Writer.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+    // A DURABLE writer that is shutting down gives up on a batch after this
+    // many consecutive failures rather than hang the exit
+    const int SHUTDOWN_ATTEMPTS = 3;
+
+}
+
+HistoryWriter::HistoryWriter(Storage* storage) : HistoryWriter(storage, Options()) {}
+
+HistoryWriter::HistoryWriter(Storage* storage, const Options& options)
+    : storage(storage), options(options), accepted(0), settled(0), flushTarget(0), stopping(false) {
+    this->options.batchSize = (std::max)(this->options.batchSize, size_t(1));
+    this->options.queueCapacity = (std::max)(this->options.queueCapacity, this->options.batchSize);
+    writer = std::thread(&HistoryWriter::run, this);
+}
+
+HistoryWriter::~HistoryWriter() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    workReady.notify_one();
+    spaceReady.notify_all();
+    writer.join();
+}
+
+bool HistoryWriter::submit(CalculationRecord record) {
+    std::vector<CalculationRecord> one;
+    one.push_back(std::move(record));
+    return submit(std::move(one));
+}
+
+bool HistoryWriter::submit(std::vector<CalculationRecord>&& records) {
+    // Stamped now, not when the batch reaches storage
+    std::string now = CalculationRecord::currentTimestamp();
+    for (CalculationRecord& record : records) {
+        if (record.calculated_at.empty()) record.calculated_at = now;
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    counters.submitted += records.size();
+
+    bool wasEmpty = queue.empty();
+    size_t taken = 0;
+    for (CalculationRecord& record : records) {
+        if (queue.size() >= options.queueCapacity) {
+            if (options.mode == Mode::THROUGHPUT) {
+                counters.dropped += records.size() - taken;
+                break;
+            }
+            workReady.notify_one();
+            spaceReady.wait(guard, [this] { return queue.size() < options.queueCapacity || stopping; });
+        }
+        if (queue.empty()) oldestQueued = std::chrono::steady_clock::now();
+        queue.push_back(std::move(record));
+        ++taken;
+    }
+    accepted += taken;
+    counters.queued = queue.size();
+
+    // The writer sleeps untimed on an empty queue; wake it to start the
+    // flush timer, or early for a full batch
+    if (wasEmpty || queue.size() >= options.batchSize) {
+        workReady.notify_one();
+    }
+    return taken == records.size();
+}
+
+bool HistoryWriter::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> guard(lock);
+    uint64_t target = accepted;
+    flushTarget = (std::max)(flushTarget, target);
+    workReady.notify_one();
+    return progress.wait_for(guard, timeout, [this, target] { return settled >= target; });
+}
+
+void HistoryWriter::run() {
+    std::vector<CalculationRecord> batch;
+    int failures = 0;
+
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        while (!stopping && queue.size() < options.batchSize && flushTarget <= settled) {
+            if (queue.empty()) {
+                workReady.wait(guard);
+            }
+            else if (workReady.wait_until(guard, oldestQueued + options.flushInterval) == std::cv_status::timeout) {
+                break;
+            }
+        }
+        if (queue.empty()) {
+            if (stopping) break;
+            continue;
+        }
+
+        size_t n = (std::min)(queue.size(), options.batchSize);
+        batch.assign(std::make_move_iterator(queue.begin()), std::make_move_iterator(queue.begin() + n));
+        queue.erase(queue.begin(), queue.begin() + n);
+        if (!queue.empty()) oldestQueued = std::chrono::steady_clock::now();
+        counters.queued = queue.size();
+        spaceReady.notify_all();
+
+        bool finalAttempts = stopping;
+        guard.unlock();
+        size_t written = 0;
+        size_t rejected = 0;
+        if (writeBatch(batch)) {
+            written = n;
+            batch.clear();
+        }
+        else if (options.mode == Mode::DURABLE && failures > 0 && n > 1) {
+            // Refused again: find out whether the backend is down or refuses
+            // particular rows, which would otherwise hold up the queue for good
+            writeRows(batch, finalAttempts ? batch.size() : static_cast<size_t>(failures), written, rejected);
+        }
+        guard.lock();
+
+        counters.written += written;
+        counters.dropped += rejected;
+        settled += written + rejected;
+
+        if (batch.empty()) {
+            failures = 0;
+            ++counters.batches;
+        }
+        else {
+            ++failures;
+            ++counters.failedBatches;
+            n = batch.size();
+            bool giveUp = options.mode == Mode::THROUGHPUT || (stopping && failures >= SHUTDOWN_ATTEMPTS);
+            if (giveUp) {
+                if (stopping) {
+                    // The backend is not coming back before exit
+                    n += queue.size();
+                    queue.clear();
+                    counters.queued = 0;
+                }
+                std::cerr << "History writer dropped " << n << " calculation record(s).\n";
+                counters.dropped += n;
+                settled += n;
+            }
+            else {
+                // Back in front, in order, and retry after a pause
+                queue.insert(queue.begin(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+                counters.queued = queue.size();
+                oldestQueued = std::chrono::steady_clock::now();
+                workReady.wait_for(guard, options.flushInterval);
+            }
+        }
+        progress.notify_all();
+    }
+    progress.notify_all();
+}
+
+bool HistoryWriter::writeBatch(const std::vector<CalculationRecord>& batch) {
+    return storage && storage->appendCalculations(batch);
+}
+
+void HistoryWriter::writeRows(std::vector<CalculationRecord>& batch, size_t probes, size_t& written, size_t& rejected) {
+    std::vector<CalculationRecord> left;
+    std::vector<size_t> refused;   // rows refused before any row went in
+    bool backendUp = false;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!backendUp && refused.size() >= probes) {
+            left.insert(left.end(), std::make_move_iterator(batch.begin() + i), std::make_move_iterator(batch.end()));
+            break;
+        }
+        if (writeBatch(std::vector<CalculationRecord>(1, batch[i]))) {
+            ++written;
+            backendUp = true;
+        }
+        else {
+            refused.push_back(i);
+            if (!backendUp) continue;
+        }
+        // The backend takes rows, so the ones it refused are at fault
+        for (size_t r : refused) {
+            std::cerr << "History writer dropped the calculation record of " << batch[r].username
+                << " for mission '" << batch[r].mission_name << "': storage refused it.\n";
+            ++rejected;
+        }
+        refused.clear();
+    }
+
+    // Nothing went in: the refused rows wait for the backend, in order
+    for (size_t r = refused.size(); r-- > 0;) {
+        left.insert(left.begin(), std::move(batch[refused[r]]));
+    }
+    batch = std::move(left);
+}
+
+HistoryWriter::Stats HistoryWriter::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+void HistoryWriter::displayStats() const {
+    Stats s = stats();
+
+    std::cout << "\n--- History Writer ---\n";
+    std::cout << "Mode: " << (options.mode == Mode::DURABLE ? "durability-first" : "throughput-first") << "\n";
+    std::cout << "Submitted: " << s.submitted << " | Written: " << s.written
+        << " | Dropped: " << s.dropped << " | Queued: " << s.queued << "\n";
+    std::cout << "Batches: " << s.batches << " (" << s.failedBatches << " failed)";
+    if (s.batches > 0) {
+        std::cout << ", average " << s.written / s.batches << " rows";
+    }
+    std::cout << "\n";
+}
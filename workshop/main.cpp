@@ -1,41 +1,130 @@
-﻿#include <iostream>
+﻿#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
 #include <string>
-#include <mysql.h> 
 #include "Database_Manager.h"
+#include "Mysql_Storage.h"
+#include "Embedded_Storage.h"
+#include "Snapshot_Storage.h"
+#include "Schema_Migrator.h"
 #include "System.h"
 #include "Auth.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     system("cls");
 
     std::cout << "========================================\n";
     std::cout << "  FUEL MANAGEMENT SYSTEM\n";
     std::cout << "========================================\n\n";
 
-    // Connect to database
+    // --embedded [directory] keeps all data in local files instead of MySQL;
+    // --slow-query-ms N sets the slow-query log threshold (0 turns it off);
+    // --history-mode throughput lets the history writer drop records rather
+    // than block when storage falls behind (default: durable);
+    // --snapshot [file] reads reference data from a memory-mapped snapshot,
+    // rebuilt first with --refresh-snapshot
+    bool embedded = false;
+    std::string dataDirectory = "fuel_data";
+    long slowQueryMs = 200;
+    HistoryWriter::Mode historyMode = HistoryWriter::Mode::DURABLE;
+    bool useSnapshot = false;
+    bool refreshSnapshot = false;
+    std::string snapshotPath = "reference.snap";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--embedded") {
+            embedded = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                dataDirectory = argv[++i];
+            }
+        }
+        else if (arg == "--slow-query-ms" && i + 1 < argc) {
+            slowQueryMs = std::atol(argv[++i]);
+        }
+        else if (arg == "--history-mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "throughput") {
+                historyMode = HistoryWriter::Mode::THROUGHPUT;
+            }
+            else if (mode != "durable") {
+                std::cerr << "Unknown history mode '" << mode << "', using durable.\n";
+            }
+        }
+        else if (arg == "--snapshot") {
+            useSnapshot = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                snapshotPath = argv[++i];
+            }
+        }
+        else if (arg == "--refresh-snapshot") {
+            useSnapshot = true;
+            refreshSnapshot = true;
+        }
+    }
+
+    // Declared before storage, which may refer to it
     DatabaseManager db;
-    if (!db.connect("localhost", "root", "", "fuel_efficiency", 3306)) {
-        std::cerr << "Failed to connect to MySQL.\n";
-        std::cout << "Press Enter to exit...";
-        std::cin.get();
-        return 1;
+    std::unique_ptr<Storage> storage;
+
+    if (embedded) {
+        std::unique_ptr<EmbeddedStorage> local(new EmbeddedStorage(dataDirectory));
+        if (!local->open()) {
+            std::cerr << "Failed to open data directory: " << dataDirectory << "\n";
+            std::cout << "Press Enter to exit...";
+            std::cin.get();
+            return 1;
+        }
+        storage = std::move(local);
     }
+    else {
+        // Connect to database
+        db.setPoolLimits(2, 8); // extra connections for parallel export jobs
+        db.setSlowQueryLog("slow_queries.log", std::chrono::milliseconds(slowQueryMs));
+        if (!db.connect("localhost", "root", "", "fuel_efficiency", 3306)) {
+            std::cerr << "Failed to connect to MySQL.\n";
+            std::cout << "Press Enter to exit...";
+            std::cin.get();
+            return 1;
+        }
 
-    Auth auth(&db);
+        // Create or upgrade the tables, then confirm the hot queries have indexes
+        SchemaMigrator schema(&db);
+        if (!schema.migrate()) {
+            std::cerr << "Failed to prepare the database schema.\n";
+            std::cout << "Press Enter to exit...";
+            std::cin.get();
+            return 1;
+        }
+        schema.verifyIndexes();
 
-    // Check if any users exist
-    bool hasUsers = false;
-    MYSQL* conn = db.getConnection();
-    if (conn) {
-        if (mysql_query(conn, "SELECT COUNT(*) FROM users") == 0) {
-            MYSQL_RES* res = mysql_store_result(conn);
-            MYSQL_ROW row = mysql_fetch_row(res);
-            int count = row ? std::atoi(row[0]) : 0;
-            mysql_free_result(res);
-            hasUsers = (count > 0);
+        storage.reset(new MySqlStorage(&db));
+    }
+
+    // Reference reads go to the snapshot, everything else to `storage`;
+    // declared after it so it is destroyed (and flushed) first
+    std::unique_ptr<SnapshotStorage> reference;
+    Storage* active = storage.get();
+    if (useSnapshot) {
+        auto start = std::chrono::steady_clock::now();
+        reference.reset(new SnapshotStorage(snapshotPath, storage.get()));
+        if (reference->open(refreshSnapshot)) {
+            active = reference.get();
+            std::cout << "Reference data mapped from " << snapshotPath << " in "
+                << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                << " ms\n";
+        }
+        else {
+            std::cerr << "Continuing without the reference snapshot.\n";
+            reference.reset();
         }
     }
 
+    Auth auth(active);
+
+    // Check if any users exist
+    bool hasUsers = storage->countUsers() > 0;
+
     // default admin
     if (!hasUsers) {
         std::cout << "No users found in database.\n";
@@ -52,9 +141,15 @@ int main() {
 
     std::cout << "\n========================================\n";
 
-    // Start the system
-    System system(&db);
-    system.runApplication();
+    // Start the system; leaving the block drains the history writer
+    {
+        System system(active, historyMode);
+        system.runApplication();
+    }
+
+    if (!embedded) {
+        db.displayQueryStats();
+    }
 
     std::cout << "\nThank you for using the Tactical Fuel Management System!\n";
     std::cout << "Press Enter to exit...";
@@ -0,0 +1,221 @@
+#include "Monte_Carlo.h"
+#include "Thread_Pool.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+
+namespace {
+    inline uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Exact order statistic; `scratch` is reordered
+    double percentile(std::vector<double>& scratch, double p) {
+        if (scratch.empty()) return 0.0;
+        size_t k = static_cast<size_t>(p * (scratch.size() - 1) + 0.5);
+        std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+        return scratch[k];
+    }
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t streamIndex) {
+    uint64_t state = seed;
+    for (uint64_t& word : s) word = splitmix64(state);
+    for (uint64_t i = 0; i < streamIndex; ++i) jump();
+}
+
+uint64_t RandomStream::next() {
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+double RandomStream::uniform() {
+    return (next() >> 11) * 0x1.0p-53;
+}
+
+void RandomStream::jump() {
+    static const uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    uint64_t t[4] = { 0, 0, 0, 0 };
+    for (uint64_t word : JUMP) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (1ULL << bit)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            next();
+        }
+    }
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+    s[3] = t[3];
+}
+
+double Distribution::sample(RandomStream& rng) const {
+    switch (kind) {
+    case Kind::UNIFORM:
+        return a + (b - a) * rng.uniform();
+    case Kind::NORMAL: {
+        // Box-Muller, one variate per call keeps the stream position simple
+        double u1 = 1.0 - rng.uniform(); // (0, 1]
+        double u2 = rng.uniform();
+        return a + b * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+    case Kind::TRIANGULAR: {
+        double u = rng.uniform();
+        double split = (c > a) ? (b - a) / (c - a) : 0.5;
+        if (u < split) return a + std::sqrt(u * (c - a) * (b - a));
+        return c - std::sqrt((1.0 - u) * (c - a) * (c - b));
+    }
+    case Kind::FIXED:
+    default:
+        return a;
+    }
+}
+
+std::string Distribution::describe() const {
+    std::ostringstream oss;
+    switch (kind) {
+    case Kind::UNIFORM: oss << "Uniform(" << a << ", " << b << ")"; break;
+    case Kind::NORMAL: oss << "Normal(" << a << ", " << b << ")"; break;
+    case Kind::TRIANGULAR: oss << "Triangular(" << a << ", " << b << ", " << c << ")"; break;
+    case Kind::FIXED:
+    default: oss << a; break;
+    }
+    return oss.str();
+}
+
+MonteCarloEngine::MonteCarloEngine(ThreadPool& pool) : pool(pool) {}
+
+MonteCarloResult MonteCarloEngine::run(const Vehicle& veh, const MonteCarloSpec& spec, size_t streams) {
+    MonteCarloResult result;
+    if (streams == 0) streams = pool.size();
+    if (streams > spec.draws) streams = spec.draws > 0 ? spec.draws : 1;
+
+    result.draws = spec.draws;
+    result.streams = streams;
+    if (spec.draws == 0) return result;
+
+    std::vector<double> samples(spec.draws);
+    std::vector<double> streamSums(streams, 0.0);
+
+    // Every draw uses the same vehicle
+    const VehicleCoefficients coefficients = veh.currentCoefficients();
+
+    // One task per stream: grain 1 over [0, streams)
+    pool.parallelFor(streams, 1, [&](size_t begin, size_t end, size_t) {
+        const size_t block = 1024;
+        double grad[block], rough[block], temp[block], dist[block], speed[block];
+        std::unique_ptr<bool[]> ac(new bool[block]);
+
+        std::fill(dist, dist + block, spec.distanceKm);
+        std::fill(ac.get(), ac.get() + block, veh.hasAC);
+
+        for (size_t k = begin; k < end; ++k) {
+            RandomStream rng(spec.seed, k);
+            size_t first = spec.draws * k / streams;
+            size_t last = spec.draws * (k + 1) / streams;
+            double sum = 0.0;
+
+            for (size_t pos = first; pos < last; pos += block) {
+                size_t n = (std::min)(block, last - pos);
+                for (size_t i = 0; i < n; ++i) {
+                    grad[i] = spec.gradient.sample(rng);
+                    rough[i] = spec.roughness.sample(rng);
+                    temp[i] = spec.temperatureC.sample(rng);
+                    speed[i] = (std::max)(1.0, spec.speedKmh.sample(rng));
+                }
+
+                MissionBatch batch;
+                batch.count = n;
+                batch.vehicle = &coefficients;
+                batch.hasAC = ac.get();
+                batch.roadGradient = grad;
+                batch.surfaceRoughness = rough;
+                batch.ambientTempC = temp;
+                batch.distanceKm = dist;
+                batch.avgSpeedKmh = speed;
+
+                double* out = samples.data() + pos;
+                calculator.calculateBatch(batch, out);
+                for (size_t i = 0; i < n; ++i) sum += out[i];
+            }
+
+            streamSums[k] = sum;
+        }
+    });
+
+    // Reduce in stream order so the floating-point sum is reproducible
+    double total = 0.0;
+    for (double s : streamSums) total += s;
+    result.mean = total / spec.draws;
+
+    double sq = 0.0;
+    result.min = samples[0];
+    result.max = samples[0];
+    for (double v : samples) {
+        double d = v - result.mean;
+        sq += d * d;
+        if (v < result.min) result.min = v;
+        if (v > result.max) result.max = v;
+    }
+    result.stddev = std::sqrt(sq / spec.draws);
+
+    size_t bins = spec.histogramBins > 0 ? spec.histogramBins : 1;
+    result.histogram.assign(bins, 0);
+    result.histogramStart = result.min;
+    result.binWidth = (result.max - result.min) / bins;
+    for (double v : samples) {
+        size_t bin = result.binWidth > 0 ? static_cast<size_t>((v - result.min) / result.binWidth) : 0;
+        if (bin >= bins) bin = bins - 1;
+        ++result.histogram[bin];
+    }
+
+    result.p5 = percentile(samples, 0.05);
+    result.p50 = percentile(samples, 0.50);
+    result.p95 = percentile(samples, 0.95);
+
+    return result;
+}
+
+void MonteCarloEngine::displayResult(const MonteCarloResult& r) const {
+    std::cout << "\n--- Monte Carlo Fuel Report ---\n";
+    std::cout << "Draws: " << r.draws << " (" << r.streams << " streams)\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Mean: " << r.mean << " L   Std Dev: " << r.stddev << " L\n";
+    std::cout << "P5: " << r.p5 << " L   P50: " << r.p50 << " L   P95: " << r.p95 << " L\n";
+    std::cout << "Range: " << r.min << " - " << r.max << " L\n\n";
+
+    size_t peak = 0;
+    for (size_t count : r.histogram) peak = (std::max)(peak, count);
+
+    for (size_t i = 0; i < r.histogram.size(); ++i) {
+        double lo = r.histogramStart + r.binWidth * i;
+        size_t bar = peak > 0 ? r.histogram[i] * 40 / peak : 0;
+        std::cout << std::right << std::setw(10) << lo << " - " << std::setw(10) << lo + r.binWidth
+            << " | " << std::string(bar, '#') << " " << r.histogram[i] << "\n";
+    }
+}
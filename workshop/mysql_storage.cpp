@@ -0,0 +1,1313 @@
+#include "Mysql_Storage.h"
+#include "Vehicle.h"
+#include "Environment.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <mysql.h>
+#include <mysqld_error.h>
+
+namespace {
+
+    const char* VEHICLE_COLUMNS = "vehicle_id, model_name, base_efficiency, mass_kg, drag_coef, frontal_area, "
+        "engine_rated_power, tire_pressure_bar, has_ac";
+
+    // Column list for the binary-protocol record queries; order matches
+    // RecordBuffers below
+    const char* RECORD_COLUMNS = "id, username, vehicle_id, mission_name, "
+        "vehicle_mass, vehicle_drag_coef, vehicle_frontal_area, vehicle_tire_pressure, "
+        "vehicle_engine_power, vehicle_has_ac, vehicle_efficiency, road_gradient, "
+        "surface_roughness, ambient_temp, pressure, distance_km, avg_speed_kmh, "
+        "fuel_consumed_liters, cost_per_km, calculated_at";
+
+    // Rows per prepared upsert. Batches are cut into statements of this many
+    // rows and a power-of-two tail, so at most nine statement shapes are
+    // ever prepared per connection.
+    const size_t MAX_UPSERT_ROWS = 256;
+
+    const char* INSERT_PREFIX = "INSERT INTO calculation_history (username, vehicle_id, mission_name, "
+        "vehicle_mass, vehicle_drag_coef, vehicle_frontal_area, vehicle_tire_pressure, "
+        "vehicle_engine_power, vehicle_has_ac, vehicle_efficiency, road_gradient, "
+        "surface_roughness, ambient_temp, pressure, distance_km, avg_speed_kmh, "
+        "fuel_consumed_liters, cost_per_km, calculated_at) VALUES ";
+
+    void bindString(MYSQL_BIND& bind, const std::string& value) {
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = (char*)value.c_str();
+        bind.buffer_length = (unsigned long)value.length();
+    }
+
+    void bindDouble(MYSQL_BIND& bind, const double& value) {
+        bind.buffer_type = MYSQL_TYPE_DOUBLE;
+        bind.buffer = (char*)&value;
+    }
+
+    // NULL for a non-positive value; COALESCE(?, column) then keeps the
+    // stored value
+    void bindPositiveOrNull(MYSQL_BIND& bind, const double& value) {
+        if (value > 0) {
+            bindDouble(bind, value);
+        }
+        else {
+            bind.buffer_type = MYSQL_TYPE_NULL;
+        }
+    }
+
+    void bindInt(MYSQL_BIND& bind, const int& value) {
+        bind.buffer_type = MYSQL_TYPE_LONG;
+        bind.buffer = (char*)&value;
+    }
+
+    void appendString(std::string& sql, MYSQL* conn, const std::string& value) {
+        size_t start = sql.size();
+        sql.resize(start + value.size() * 2 + 3);
+        sql[start] = '\'';
+        unsigned long n = mysql_real_escape_string(conn, &sql[start + 1], value.c_str(), (unsigned long)value.size());
+        sql[start + 1 + n] = '\'';
+        sql.resize(start + n + 2);
+    }
+
+    // Shortest representation that reads back to the same double
+    void appendDouble(std::string& sql, double value) {
+        if (!std::isfinite(value)) {
+            sql += "NULL";
+            return;
+        }
+        char buffer[32];
+        std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        sql.append(buffer, r.ptr);
+    }
+
+    // "YYYY-MM-DD HH:MM:SS[.ffffff]" by hand; snprintf was a quarter of the
+    // per-row cost of an export. Fractional seconds, if the column keeps
+    // them, are part of the pagination key and must survive the round trip.
+    void formatDateTime(const MYSQL_TIME& t, std::string& out) {
+        char text[27] = "0000-00-00 00:00:00.000000";
+        unsigned year = t.year % 10000;
+        text[0] = char('0' + year / 1000);
+        text[1] = char('0' + year / 100 % 10);
+        text[2] = char('0' + year / 10 % 10);
+        text[3] = char('0' + year % 10);
+        const unsigned parts[5] = { t.month % 100, t.day % 100, t.hour % 100, t.minute % 100, t.second % 100 };
+        const int at[5] = { 5, 8, 11, 14, 17 };
+        for (int k = 0; k < 5; ++k) {
+            text[at[k]] = char('0' + parts[k] / 10);
+            text[at[k] + 1] = char('0' + parts[k] % 10);
+        }
+
+        size_t length = 19;
+        if (t.second_part != 0) {
+            unsigned long micros = t.second_part % 1000000;
+            for (int k = 25; k >= 20; --k) {
+                text[k] = char('0' + micros % 10);
+                micros /= 10;
+            }
+            length = 26;
+        }
+        out.assign(text, length);
+    }
+
+    // Result buffers for one calculation_history row. Doubles arrive as
+    // doubles; text longer than TEXT_SIZE is fetched again at full length.
+    struct RecordBuffers {
+        static const int COLUMNS = 20;
+        static const unsigned long TEXT_SIZE = 256;
+
+        int id;
+        char text[3][TEXT_SIZE];          // username, vehicle_id, mission_name
+        unsigned long textLength[3];
+        double values[14];                // columns 4-8 and 10-18
+        int hasAC;
+        MYSQL_TIME calculatedAt;
+
+        MYSQL_BIND bind[COLUMNS];
+        my_bool isNull[COLUMNS];
+        my_bool truncated[COLUMNS];
+
+        RecordBuffers() {
+            memset(bind, 0, sizeof(bind));
+            for (int c = 0; c < COLUMNS; ++c) {
+                bind[c].is_null = &isNull[c];
+                bind[c].error = &truncated[c];
+            }
+
+            bind[0].buffer_type = MYSQL_TYPE_LONG;
+            bind[0].buffer = &id;
+            for (int t = 0; t < 3; ++t) {
+                bind[1 + t].buffer_type = MYSQL_TYPE_STRING;
+                bind[1 + t].buffer = text[t];
+                bind[1 + t].buffer_length = TEXT_SIZE;
+                bind[1 + t].length = &textLength[t];
+            }
+            for (int v = 0; v < 14; ++v) {
+                int column = v < 5 ? 4 + v : 5 + v;
+                bind[column].buffer_type = MYSQL_TYPE_DOUBLE;
+                bind[column].buffer = &values[v];
+            }
+            bind[9].buffer_type = MYSQL_TYPE_LONG;
+            bind[9].buffer = &hasAC;
+            bind[19].buffer_type = MYSQL_TYPE_DATETIME;
+            bind[19].buffer = &calculatedAt;
+        }
+
+        void textColumn(MYSQL_STMT* stmt, int t, std::string& out) {
+            int column = 1 + t;
+            if (isNull[column]) {
+                out.clear();
+                return;
+            }
+            if (!truncated[column]) {
+                out.assign(text[t], textLength[t]);
+                return;
+            }
+
+            out.assign(textLength[t], '\0');
+            MYSQL_BIND whole;
+            memset(&whole, 0, sizeof(whole));
+            whole.buffer_type = MYSQL_TYPE_STRING;
+            whole.buffer = &out[0];
+            whole.buffer_length = textLength[t];
+            mysql_stmt_fetch_column(stmt, &whole, column, 0);
+        }
+
+        // Overwrites every field, so one record can be refilled row after row
+        void fill(MYSQL_STMT* stmt, CalculationRecord& record) {
+            double* fields[14] = {
+                &record.vehicle_mass, &record.vehicle_drag_coef, &record.vehicle_frontal_area,
+                &record.vehicle_tire_pressure, &record.vehicle_engine_power,
+                &record.vehicle_efficiency, &record.road_gradient, &record.surface_roughness,
+                &record.ambient_temp, &record.pressure, &record.distance_km,
+                &record.avg_speed_kmh, &record.fuel_consumed_liters, &record.cost_per_km
+            };
+
+            record.id = isNull[0] ? 0 : id;
+            textColumn(stmt, 0, record.username);
+            textColumn(stmt, 1, record.vehicle_id);
+            textColumn(stmt, 2, record.mission_name);
+            for (int v = 0; v < 14; ++v) {
+                int column = v < 5 ? 4 + v : 5 + v;
+                *fields[v] = isNull[column] ? 0.0 : values[v];
+            }
+            record.vehicle_has_ac = !isNull[9] && hasAC == 1;
+
+            if (isNull[19]) {
+                record.calculated_at.clear();
+            }
+            else {
+                formatDateTime(calculatedAt, record.calculated_at);
+            }
+        }
+    };
+
+}
+
+MySqlStorage::MySqlStorage(DatabaseManager* db) : db(db) {}
+
+int MySqlStorage::executeUpdate(const char* sql, MYSQL_BIND* params) {
+    MYSQL_STMT* stmt = db->prepare(sql);
+    if (!stmt) {
+        return -1;
+    }
+
+    if (mysql_stmt_bind_param(stmt, params) != 0) {
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return -1;
+    }
+
+    if (!db->execute(stmt)) {
+        // An insert whose key is taken affects no rows; anything else is an error
+        bool duplicate = mysql_stmt_errno(stmt) == ER_DUP_ENTRY;
+        if (!duplicate) {
+            std::cerr << "Failed to execute statement: " << mysql_stmt_error(stmt) << std::endl;
+        }
+        db->finish(stmt);
+        return duplicate ? 0 : -1;
+    }
+
+    int affected = (int)mysql_stmt_affected_rows(stmt);
+    db->finish(stmt);
+    return affected;
+}
+
+// VEHICLES
+
+bool MySqlStorage::vehicleExists(const std::string& id) {
+    if (!db->getConnection()) return false;
+
+    const char* sql = "SELECT COUNT(*) FROM vehicles WHERE vehicle_id = ?";
+    MYSQL_STMT* stmt = db->prepare(sql);
+
+    bool exists = false;
+    if (stmt) {
+        MYSQL_BIND bind[1];
+        memset(bind, 0, sizeof(bind));
+        bindString(bind[0], id);
+
+        mysql_stmt_bind_param(stmt, bind);
+        db->execute(stmt);
+
+        int count = 0;
+        MYSQL_BIND result_bind[1];
+        memset(result_bind, 0, sizeof(result_bind));
+        result_bind[0].buffer_type = MYSQL_TYPE_LONG;
+        result_bind[0].buffer = &count;
+
+        mysql_stmt_bind_result(stmt, result_bind);
+        if (db->fetch(stmt) == 0) {
+            exists = (count > 0);
+        }
+    }
+
+    db->finish(stmt);
+    return exists;
+}
+
+bool MySqlStorage::loadVehicle(const std::string& id, Vehicle& out) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return false;
+    }
+
+    std::string sql = std::string("SELECT ") + VEHICLE_COLUMNS + " FROM vehicles WHERE vehicle_id = ?";
+    MYSQL_STMT* stmt = db->prepare(sql);
+
+    if (!stmt) {
+        return false;
+    }
+
+    // Bind the vehicle ID parameter
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], id);
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0) {
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute query: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    // Bind result
+    MYSQL_BIND result_bind[9];
+    memset(result_bind, 0, sizeof(result_bind));
+
+    char db_id[50];
+    char model_name_buf[100];
+    double values[6]; // efficiency, mass, drag, area, power, tire pressure
+    int has_ac;
+
+    unsigned long length[9];
+    my_bool is_null[9];
+
+    result_bind[0].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[0].buffer = db_id;
+    result_bind[0].buffer_length = sizeof(db_id);
+
+    result_bind[1].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[1].buffer = model_name_buf;
+    result_bind[1].buffer_length = sizeof(model_name_buf);
+
+    for (int v = 0; v < 6; ++v) {
+        result_bind[2 + v].buffer_type = MYSQL_TYPE_DOUBLE;
+        result_bind[2 + v].buffer = &values[v];
+    }
+
+    result_bind[8].buffer_type = MYSQL_TYPE_LONG;
+    result_bind[8].buffer = &has_ac;
+
+    for (int c = 0; c < 9; ++c) {
+        result_bind[c].length = &length[c];
+        result_bind[c].is_null = &is_null[c];
+    }
+
+    if (mysql_stmt_bind_result(stmt, result_bind) != 0) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    bool found = (db->fetch(stmt) == 0);
+    if (found) {
+        out.vehicle_id.assign(db_id, is_null[0] ? 0 : (std::min)(length[0], (unsigned long)sizeof(db_id)));
+        out.model_name.assign(model_name_buf, is_null[1] ? 0 : (std::min)(length[1], (unsigned long)sizeof(model_name_buf)));
+        out.efficiency = is_null[2] ? 0 : values[0];
+        out.massKg = is_null[3] ? 0 : values[1];
+        out.dragCoef = is_null[4] ? 0 : values[2];
+        out.frontalArea = is_null[5] ? 0 : values[3];
+        out.engineRatedPower = is_null[6] ? 0 : values[4];
+        out.tirePressureBar = is_null[7] ? 2.4 : values[5];
+        out.hasAC = !is_null[8] && has_ac == 1;
+    }
+
+    db->finish(stmt);
+    return found;
+}
+
+bool MySqlStorage::loadAllVehicles(std::vector<Vehicle>& vehicles) {
+    vehicles.clear();
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return false;
+    }
+
+    std::string query = std::string("SELECT ") + VEHICLE_COLUMNS + " FROM vehicles ORDER BY vehicle_id";
+
+    MYSQL_RES* res = db->queryResult(query);
+    if (!res) {
+        std::cerr << "Failed to load vehicles: " << mysql_error(db->getConnection()) << std::endl;
+        return false;
+    }
+
+    vehicles.reserve((size_t)mysql_num_rows(res));
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(res))) {
+        Vehicle v(this);
+        v.vehicle_id = row[0] ? row[0] : "";
+        v.model_name = row[1] ? row[1] : "";
+        v.efficiency = row[2] ? std::atof(row[2]) : 0;
+        v.massKg = row[3] ? std::atof(row[3]) : 0;
+        v.dragCoef = row[4] ? std::atof(row[4]) : 0;
+        v.frontalArea = row[5] ? std::atof(row[5]) : 0;
+        v.engineRatedPower = row[6] ? std::atof(row[6]) : 0;
+        v.tirePressureBar = row[7] ? std::atof(row[7]) : 2.4;
+        v.hasAC = row[8] && std::atoi(row[8]) == 1;
+        vehicles.push_back(v);
+    }
+
+    mysql_free_result(res);
+    return true;
+}
+
+int MySqlStorage::insertVehicle(const Vehicle& vehicle) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    const char* sql = "INSERT INTO vehicles (vehicle_id, model_name, base_efficiency, mass_kg, drag_coef, frontal_area, engine_rated_power, tire_pressure_bar, has_ac) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+    MYSQL_BIND bind[9];
+    memset(bind, 0, sizeof(bind));
+
+    bindString(bind[0], vehicle.vehicle_id);
+    bindString(bind[1], vehicle.model_name);
+    bindDouble(bind[2], vehicle.efficiency);
+    bindDouble(bind[3], vehicle.massKg);
+    bindDouble(bind[4], vehicle.dragCoef);
+    bindDouble(bind[5], vehicle.frontalArea);
+    bindDouble(bind[6], vehicle.engineRatedPower);
+    bindDouble(bind[7], vehicle.tirePressureBar);
+    int acInt = vehicle.hasAC ? 1 : 0;
+    bindInt(bind[8], acInt);
+
+    return executeUpdate(sql, bind);
+}
+
+int MySqlStorage::updateVehicle(const Vehicle& changes) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    // The merge with the stored row happens in the statement, so there is no
+    // read before the write and no window for another writer in between
+    const char* sql = "UPDATE vehicles SET "
+        "model_name = COALESCE(NULLIF(?, ''), model_name), "
+        "base_efficiency = COALESCE(?, base_efficiency), "
+        "mass_kg = COALESCE(?, mass_kg), "
+        "drag_coef = COALESCE(?, drag_coef), "
+        "frontal_area = COALESCE(?, frontal_area), "
+        "engine_rated_power = COALESCE(?, engine_rated_power), "
+        "tire_pressure_bar = COALESCE(?, tire_pressure_bar), "
+        "has_ac = ? "
+        "WHERE vehicle_id = ?";
+
+    MYSQL_BIND bind[9];
+    memset(bind, 0, sizeof(bind));
+
+    bindString(bind[0], changes.model_name);
+    bindPositiveOrNull(bind[1], changes.efficiency);
+    bindPositiveOrNull(bind[2], changes.massKg);
+    bindPositiveOrNull(bind[3], changes.dragCoef);
+    bindPositiveOrNull(bind[4], changes.frontalArea);
+    bindPositiveOrNull(bind[5], changes.engineRatedPower);
+    bindPositiveOrNull(bind[6], changes.tirePressureBar);
+    int acInt = changes.hasAC ? 1 : 0;
+    bindInt(bind[7], acInt);
+    bindString(bind[8], changes.vehicle_id);
+
+    return executeUpdate(sql, bind);
+}
+
+int MySqlStorage::deleteVehicle(const std::string& id) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], id);
+
+    return executeUpdate("DELETE FROM vehicles WHERE vehicle_id = ?", bind);
+}
+
+int MySqlStorage::upsertVehicles(const std::vector<Vehicle>& vehicles) {
+    if (vehicles.empty()) return 0;
+
+    // All statements of the batch commit together or not at all. They run on
+    // a lease, which is validated once when handed out, so the primary
+    // connection cannot be reopened halfway through the transaction
+    DatabaseManager::Lease lease = db->acquire();
+    if (!lease) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    if (!db->query("START TRANSACTION")) {
+        std::cerr << "Failed to start transaction: " << mysql_error(db->getConnection()) << std::endl;
+        return -1;
+    }
+
+    size_t done = 0;
+    while (done < vehicles.size()) {
+        size_t rows = MAX_UPSERT_ROWS;
+        while (rows > vehicles.size() - done) rows >>= 1;
+
+        if (upsertVehicleRows(&vehicles[done], rows) < 0) {
+            db->query("ROLLBACK");
+            return -1;
+        }
+        done += rows;
+    }
+
+    if (!db->query("COMMIT")) {
+        std::cerr << "Failed to commit vehicles: " << mysql_error(db->getConnection()) << std::endl;
+        db->query("ROLLBACK");
+        return -1;
+    }
+    return (int)vehicles.size();
+}
+
+int MySqlStorage::upsertVehicleRows(const Vehicle* vehicles, size_t count) {
+    std::string sql = std::string("INSERT INTO vehicles (") + VEHICLE_COLUMNS + ") VALUES ";
+    for (size_t i = 0; i < count; ++i) {
+        sql += i == 0 ? "(?, ?, ?, ?, ?, ?, ?, ?, ?)" : ", (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    }
+    sql += " ON DUPLICATE KEY UPDATE "
+        "model_name = VALUES(model_name), "
+        "base_efficiency = VALUES(base_efficiency), "
+        "mass_kg = VALUES(mass_kg), "
+        "drag_coef = VALUES(drag_coef), "
+        "frontal_area = VALUES(frontal_area), "
+        "engine_rated_power = VALUES(engine_rated_power), "
+        "tire_pressure_bar = VALUES(tire_pressure_bar), "
+        "has_ac = VALUES(has_ac)";
+
+    std::vector<MYSQL_BIND> bind(count * 9);
+    memset(bind.data(), 0, bind.size() * sizeof(MYSQL_BIND));
+    std::vector<int> acFlags(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vehicle& v = vehicles[i];
+        MYSQL_BIND* row = &bind[i * 9];
+        bindString(row[0], v.vehicle_id);
+        bindString(row[1], v.model_name);
+        bindDouble(row[2], v.efficiency);
+        bindDouble(row[3], v.massKg);
+        bindDouble(row[4], v.dragCoef);
+        bindDouble(row[5], v.frontalArea);
+        bindDouble(row[6], v.engineRatedPower);
+        bindDouble(row[7], v.tirePressureBar);
+        acFlags[i] = v.hasAC ? 1 : 0;
+        bindInt(row[8], acFlags[i]);
+    }
+
+    return executeUpdate(sql.c_str(), bind.data());
+}
+
+// MISSION PRESETS
+
+bool MySqlStorage::savePreset(const MissionPreset& preset) {
+    MYSQL_BIND bind[4];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], preset.name);
+    bindDouble(bind[1], preset.roadGradient);
+    bindDouble(bind[2], preset.surfaceRoughness);
+    bindDouble(bind[3], preset.ambientTempC);
+
+    // Found rows are counted, so an unchanged preset still reports 1
+    int affected = executeUpdate("INSERT INTO presets (name, road_gradient, surface_roughness, ambient_temp) "
+        "VALUES (?, ?, ?, ?) ON DUPLICATE KEY UPDATE "
+        "road_gradient = VALUES(road_gradient), "
+        "surface_roughness = VALUES(surface_roughness), "
+        "ambient_temp = VALUES(ambient_temp)", bind);
+    if (affected <= 0) {
+        std::cerr << "Failed to save profile '" << preset.name << "'.\n";
+        return false;
+    }
+    return true;
+}
+
+int MySqlStorage::loadPreset(const std::string& name, MissionPreset& out) {
+    if (!db->getConnection()) return -1;
+
+    // The name comes back as stored: the column's collation matches it
+    // regardless of case and accents
+    MYSQL_STMT* stmt = db->prepare("SELECT name, road_gradient, surface_roughness, ambient_temp FROM presets WHERE name = ?");
+    if (!stmt) return -1;
+
+    int found = -1;
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], name);
+    mysql_stmt_bind_param(stmt, bind);
+
+    if (db->execute(stmt)) {
+        char name_buf[400];   // VARCHAR(100), up to 4 bytes a character
+        unsigned long name_len = 0;
+        double values[3]; // gradient, roughness, temperature
+
+        MYSQL_BIND res_bind[4];
+        memset(res_bind, 0, sizeof(res_bind));
+        res_bind[0].buffer_type = MYSQL_TYPE_STRING;
+        res_bind[0].buffer = name_buf;
+        res_bind[0].buffer_length = sizeof(name_buf);
+        res_bind[0].length = &name_len;
+        for (int v = 0; v < 3; ++v) {
+            res_bind[1 + v].buffer_type = MYSQL_TYPE_DOUBLE;
+            res_bind[1 + v].buffer = &values[v];
+        }
+        mysql_stmt_bind_result(stmt, res_bind);
+
+        int status = db->fetch(stmt);
+        if (status == 0) {
+            out.name.assign(name_buf, (std::min)(name_len, (unsigned long)sizeof(name_buf)));
+            out.roadGradient = values[0];
+            out.surfaceRoughness = values[1];
+            out.ambientTempC = values[2];
+            found = 1;
+        }
+        else if (status == MYSQL_NO_DATA) {
+            found = 0;
+        }
+    }
+    if (found < 0) {
+        std::cerr << "Failed to load preset: " << mysql_stmt_error(stmt) << std::endl;
+    }
+    db->finish(stmt);
+    return found;
+}
+
+bool MySqlStorage::listPresets(std::vector<MissionPreset>& presets) {
+    presets.clear();
+    if (!db->getConnection()) return false;
+
+    MYSQL_STMT* stmt = db->prepare("SELECT name, road_gradient, surface_roughness, ambient_temp FROM presets ORDER BY name");
+    if (!stmt) return false;
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to list presets: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    char name_buf[400];   // VARCHAR(100), up to 4 bytes a character
+    unsigned long name_len = 0;
+    double values[3]; // gradient, roughness, temperature
+
+    MYSQL_BIND res_bind[4];
+    memset(res_bind, 0, sizeof(res_bind));
+    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
+    res_bind[0].buffer = name_buf;
+    res_bind[0].buffer_length = sizeof(name_buf);
+    res_bind[0].length = &name_len;
+    for (int v = 0; v < 3; ++v) {
+        res_bind[1 + v].buffer_type = MYSQL_TYPE_DOUBLE;
+        res_bind[1 + v].buffer = &values[v];
+    }
+
+    if (mysql_stmt_bind_result(stmt, res_bind) != 0 || mysql_stmt_store_result(stmt) != 0) {
+        std::cerr << "Failed to read presets: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    while (db->fetch(stmt) == 0) {
+        MissionPreset preset;
+        preset.name.assign(name_buf, (std::min)(name_len, (unsigned long)sizeof(name_buf)));
+        preset.roadGradient = values[0];
+        preset.surfaceRoughness = values[1];
+        preset.ambientTempC = values[2];
+        presets.push_back(preset);
+    }
+
+    db->finish(stmt);
+    return true;
+}
+
+int MySqlStorage::deletePreset(const std::string& name) {
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], name);
+
+    return executeUpdate("DELETE FROM presets WHERE name = ?", bind);
+}
+
+// ENVIRONMENT PRESETS
+
+bool MySqlStorage::findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) {
+    if (!db->getConnection()) return false;
+    std::string query = "SELECT gradient, roughness, temperature, pressure FROM environment_presets WHERE terrain_type = ? OR climate_type = ? LIMIT 1";
+
+    bool found = false;
+    MYSQL_STMT* stmt = db->prepare(query);
+    if (stmt) {
+        MYSQL_BIND bind[2];
+        memset(bind, 0, sizeof(bind));
+        bindString(bind[0], terrain);
+        bindString(bind[1], climate);
+
+        mysql_stmt_bind_param(stmt, bind);
+
+        if (db->execute(stmt)) {
+            double values[4]; // gradient, roughness, temperature, pressure
+
+            MYSQL_BIND res_bind[4];
+            memset(res_bind, 0, sizeof(res_bind));
+            for (int v = 0; v < 4; ++v) {
+                res_bind[v].buffer_type = MYSQL_TYPE_DOUBLE;
+                res_bind[v].buffer = &values[v];
+            }
+
+            mysql_stmt_bind_result(stmt, res_bind);
+
+            if (db->fetch(stmt) == 0) {
+                out.roadGradient = values[0];
+                out.surfaceRoughness = values[1];
+                out.ambientTempC = values[2];
+                out.pressurePa = values[3];
+                found = true;
+            }
+        }
+    }
+    db->finish(stmt);
+    return found;
+}
+
+bool MySqlStorage::listEnvironments(std::vector<EnvironmentPreset>& environments) {
+    environments.clear();
+    if (!db->getConnection()) return false;
+
+    MYSQL_RES* res = db->queryResult("SELECT terrain_type, climate_type, gradient, roughness, temperature, pressure "
+        "FROM environment_presets ORDER BY id");
+    if (!res) {
+        std::cerr << "Failed to list environment presets: " << mysql_error(db->getConnection()) << std::endl;
+        return false;
+    }
+
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(res))) {
+        EnvironmentPreset preset;
+        preset.terrain = row[0] ? row[0] : "";
+        preset.climate = row[1] ? row[1] : "";
+        preset.gradient = row[2] ? std::atof(row[2]) : 0;
+        preset.roughness = row[3] ? std::atof(row[3]) : 0;
+        preset.temperature = row[4] ? std::atof(row[4]) : 0;
+        preset.pressure = row[5] ? std::atof(row[5]) : 0;
+        environments.push_back(preset);
+    }
+    mysql_free_result(res);
+    return true;
+}
+
+// FUEL PRICE
+
+bool MySqlStorage::loadFuelPrice(double& price) {
+    MYSQL* conn = db->getConnection();
+    if (!conn) {
+        return false;
+    }
+
+    MYSQL_RES* result = db->queryResult("SELECT price FROM fuel_prices ORDER BY update_time DESC LIMIT 1");
+    if (!result) {
+        std::cerr << "Query failed: " << mysql_error(conn) << std::endl;
+        return false;
+    }
+
+    MYSQL_ROW row = mysql_fetch_row(result);
+    bool found = row && row[0];
+    if (found) {
+        price = std::stod(row[0]);
+    }
+
+    mysql_free_result(result);
+    return found;
+}
+
+bool MySqlStorage::saveFuelPrice(double price) {
+    MYSQL* conn = db->getConnection();
+    if (!conn) {
+        return false;
+    }
+
+    std::ostringstream oss;
+    oss << "INSERT INTO fuel_prices (price) VALUES (" << std::fixed << std::setprecision(2) << price << ")";
+    std::string query = oss.str();
+
+    if (!db->query(query, "INSERT INTO fuel_prices (price) VALUES (...)")) {
+        std::cerr << "Insert failed: " << mysql_error(conn) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// USERS
+
+bool MySqlStorage::findUser(const std::string& username, UserAccount& out) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return false;
+    }
+
+    const char* query = "SELECT password_hash, role FROM users WHERE username = ? LIMIT 1";
+    MYSQL_STMT* stmt = db->prepare(query);
+
+    if (!stmt) {
+        return false;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], username);
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0) {
+        std::cerr << "Failed to bind parameters for user lookup.\n";
+        db->finish(stmt);
+        return false;
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute user lookup.\n";
+        db->finish(stmt);
+        return false;
+    }
+
+    char stored_hash[256] = { 0 };
+    char role_buf[10] = { 0 };
+    unsigned long hash_length = 0;
+    unsigned long role_length = 0;
+    MYSQL_BIND res_bind[2];
+    memset(res_bind, 0, sizeof(res_bind));
+    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
+    res_bind[0].buffer = stored_hash;
+    res_bind[0].buffer_length = sizeof(stored_hash);
+    res_bind[0].length = &hash_length;
+    res_bind[1].buffer_type = MYSQL_TYPE_STRING;
+    res_bind[1].buffer = role_buf;
+    res_bind[1].buffer_length = sizeof(role_buf);
+    res_bind[1].length = &role_length;
+
+    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
+        std::cerr << "Failed to bind result for user lookup.\n";
+        db->finish(stmt);
+        return false;
+    }
+
+    bool found = (db->fetch(stmt) == 0);
+    if (found) {
+        out.username = username;
+        out.passwordHash.assign(stored_hash, (std::min)(hash_length, (unsigned long)sizeof(stored_hash)));
+        out.role.assign(role_buf, (std::min)(role_length, (unsigned long)sizeof(role_buf)));
+    }
+
+    db->finish(stmt);
+    return found;
+}
+
+std::vector<UserAccount> MySqlStorage::listUsers() {
+    std::vector<UserAccount> users;
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return users;
+    }
+
+    const char* query = "SELECT username, role FROM users ORDER BY username";
+    MYSQL_STMT* stmt = db->prepare(query);
+
+    if (!stmt) {
+        return users;
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute list users statement: "
+            << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return users;
+    }
+
+    // Bind result columns
+    char username_buf[256];
+    char role_buf[10];
+    unsigned long username_len = 0;
+    unsigned long role_len = 0;
+
+    MYSQL_BIND res_bind[2];
+    memset(res_bind, 0, sizeof(res_bind));
+
+    res_bind[0].buffer_type = MYSQL_TYPE_STRING;
+    res_bind[0].buffer = username_buf;
+    res_bind[0].buffer_length = sizeof(username_buf);
+    res_bind[0].length = &username_len;
+
+    res_bind[1].buffer_type = MYSQL_TYPE_STRING;
+    res_bind[1].buffer = role_buf;
+    res_bind[1].buffer_length = sizeof(role_buf);
+    res_bind[1].length = &role_len;
+
+    if (mysql_stmt_bind_result(stmt, res_bind) != 0) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return users;
+    }
+
+    // Store results
+    if (mysql_stmt_store_result(stmt) != 0) {
+        std::cerr << "Failed to store result: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return users;
+    }
+
+    while (db->fetch(stmt) == 0) {
+        UserAccount user;
+        user.username.assign(username_buf, username_len);
+        user.role.assign(role_buf, role_len);
+        users.push_back(user);
+    }
+
+    db->finish(stmt);
+    return users;
+}
+
+int MySqlStorage::countUsers() {
+    MYSQL* conn = db->getConnection();
+    if (!conn) {
+        return -1;
+    }
+
+    MYSQL_RES* res = db->queryResult("SELECT COUNT(*) FROM users");
+    if (!res) {
+        std::cerr << "Failed to count users: " << mysql_error(conn) << std::endl;
+        return -1;
+    }
+    MYSQL_ROW row = mysql_fetch_row(res);
+    int count = (row && row[0]) ? std::atoi(row[0]) : 0;
+    mysql_free_result(res);
+    return count;
+}
+
+int MySqlStorage::insertUser(const UserAccount& user) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    // Use ENUM strings 'admin' or 'user'
+    MYSQL_BIND bind[3];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], user.username);
+    bindString(bind[1], user.passwordHash);
+    bindString(bind[2], user.role);
+
+    return executeUpdate("INSERT INTO users (username, password_hash, role) VALUES (?, ?, ?)", bind);
+}
+
+int MySqlStorage::updatePasswordHash(const std::string& username, const std::string& passwordHash) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[2];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], passwordHash);
+    bindString(bind[1], username);
+
+    return executeUpdate("UPDATE users SET password_hash = ? WHERE username = ?", bind);
+}
+
+int MySqlStorage::updateRole(const std::string& username, const std::string& role) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[2];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], role);
+    bindString(bind[1], username);
+
+    return executeUpdate("UPDATE users SET role = ? WHERE username = ?", bind);
+}
+
+int MySqlStorage::deleteUser(const std::string& username) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], username);
+
+    return executeUpdate("DELETE FROM users WHERE username = ?", bind);
+}
+
+// CALCULATION HISTORY
+
+bool MySqlStorage::appendCalculations(const std::vector<CalculationRecord>& records) {
+    if (records.empty()) return true;
+
+    // Called from the history writer thread, which has no connection of its own
+    DatabaseManager::Lease lease = db->acquire(std::chrono::seconds(5));
+    if (!lease) return false;
+    MYSQL* conn = lease.get();
+
+    // One multi-row INSERT per call; the buffer is kept between batches
+    thread_local std::string sql;
+    sql.assign(INSERT_PREFIX);
+    for (size_t i = 0; i < records.size(); ++i) {
+        const CalculationRecord& r = records[i];
+        sql += i == 0 ? "(" : ",(";
+        appendString(sql, conn, r.username);
+        sql += ',';
+        appendString(sql, conn, r.vehicle_id);
+        sql += ',';
+        appendString(sql, conn, r.mission_name);
+
+        const double before[] = { r.vehicle_mass, r.vehicle_drag_coef, r.vehicle_frontal_area,
+            r.vehicle_tire_pressure, r.vehicle_engine_power };
+        for (double value : before) {
+            sql += ',';
+            appendDouble(sql, value);
+        }
+        sql += r.vehicle_has_ac ? ",1" : ",0";
+
+        const double after[] = { r.vehicle_efficiency, r.road_gradient, r.surface_roughness,
+            r.ambient_temp, r.pressure, r.distance_km, r.avg_speed_kmh,
+            r.fuel_consumed_liters, r.cost_per_km };
+        for (double value : after) {
+            sql += ',';
+            appendDouble(sql, value);
+        }
+        sql += ',';
+        if (r.calculated_at.empty()) sql += "NOW()";
+        else appendString(sql, conn, r.calculated_at);
+        sql += ')';
+    }
+
+    if (!db->query(sql, "INSERT INTO calculation_history (...) VALUES (...), ...")) {
+        std::cerr << "Failed to write calculation history: " << mysql_error(conn) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<CalculationRecord> MySqlStorage::queryCalculations(const CalculationQuery& query) {
+    std::vector<CalculationRecord> records;
+
+    if (!db->getConnection() || query.limit <= 0) {
+        return records;
+    }
+
+    // Expanded row comparison for the cursor so the optimizer sees a range
+    // on the (username,) calculated_at, id index
+    std::string sql = std::string("SELECT ") + RECORD_COLUMNS + " FROM calculation_history WHERE 1=1";
+    std::vector<const std::string*> params;
+
+    if (!query.username.empty()) {
+        sql += " AND username = ?";
+        params.push_back(&query.username);
+    }
+    if (!query.vehicleId.empty()) {
+        sql += " AND vehicle_id = ?";
+        params.push_back(&query.vehicleId);
+    }
+    if (!query.fromDate.empty()) {
+        sql += " AND calculated_at >= ?";
+        params.push_back(&query.fromDate);
+    }
+    if (!query.toDate.empty()) {
+        sql += " AND calculated_at <= ?";
+        params.push_back(&query.toDate);
+    }
+    if (query.hasCursor) {
+        sql += query.newer ? " AND (calculated_at > ? OR (calculated_at = ? AND id > ?))"
+                           : " AND (calculated_at < ? OR (calculated_at = ? AND id < ?))";
+        params.push_back(&query.cursorTime);
+        params.push_back(&query.cursorTime);
+    }
+    sql += query.newer ? " ORDER BY calculated_at ASC, id ASC LIMIT ?"
+                       : " ORDER BY calculated_at DESC, id DESC LIMIT ?";
+
+    MYSQL_STMT* stmt = db->prepare(sql);
+    if (!stmt) {
+        return records;
+    }
+
+    MYSQL_BIND bind[8];
+    memset(bind, 0, sizeof(bind));
+    size_t param = 0;
+    for (const std::string* value : params) {
+        bindString(bind[param++], *value);
+    }
+    if (query.hasCursor) {
+        bindInt(bind[param++], query.cursorId);
+    }
+    bindInt(bind[param], query.limit);
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0) {
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return records;
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute query: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return records;
+    }
+
+    records = fetchRecords(stmt);
+    db->finish(stmt);
+    return records;
+}
+
+bool MySqlStorage::getCalculation(int id, CalculationRecord& out) {
+    if (!db->getConnection()) {
+        return false;
+    }
+
+    std::string sql = std::string("SELECT ") + RECORD_COLUMNS + " FROM calculation_history WHERE id = ?";
+    MYSQL_STMT* stmt = db->prepare(sql);
+    if (!stmt) {
+        return false;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindInt(bind[0], id);
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0 || !db->execute(stmt)) {
+        std::cerr << "Failed to execute query: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    std::vector<CalculationRecord> records = fetchRecords(stmt);
+    db->finish(stmt);
+    if (records.empty()) {
+        return false;
+    }
+    out = records.front();
+    return true;
+}
+
+int MySqlStorage::deleteCalculation(int id, const std::string& owner) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[2];
+    memset(bind, 0, sizeof(bind));
+    bindInt(bind[0], id);
+    if (owner.empty()) {
+        return executeUpdate("DELETE FROM calculation_history WHERE id = ?", bind);
+    }
+    bindString(bind[1], owner);
+    return executeUpdate("DELETE FROM calculation_history WHERE id = ? AND username = ?", bind);
+}
+
+int MySqlStorage::deleteUserCalculations(const std::string& username) {
+    if (!db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return -1;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    bindString(bind[0], username);
+
+    return executeUpdate("DELETE FROM calculation_history WHERE username = ?", bind);
+}
+
+CalculationTotals MySqlStorage::calculationTotals(const std::string& username) {
+    CalculationTotals totals;
+    if (!db->getConnection()) {
+        return totals;
+    }
+
+    // One round trip for all three figures
+    std::string query = "SELECT COUNT(*), COALESCE(SUM(fuel_consumed_liters), 0), "
+        "COALESCE(AVG(fuel_consumed_liters), 0) FROM calculation_history";
+    if (!username.empty()) {
+        query += " WHERE username = ?";
+    }
+
+    MYSQL_STMT* stmt = db->prepare(query);
+    if (!stmt) {
+        return totals;
+    }
+
+    MYSQL_BIND bind[1];
+    memset(bind, 0, sizeof(bind));
+    if (!username.empty()) {
+        bindString(bind[0], username);
+    }
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0) {
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return totals;
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute query: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return totals;
+    }
+
+    MYSQL_BIND result_bind[3];
+    memset(result_bind, 0, sizeof(result_bind));
+    result_bind[0].buffer_type = MYSQL_TYPE_LONG;
+    result_bind[0].buffer = &totals.count;
+    result_bind[1].buffer_type = MYSQL_TYPE_DOUBLE;
+    result_bind[1].buffer = &totals.totalFuel;
+    result_bind[2].buffer_type = MYSQL_TYPE_DOUBLE;
+    result_bind[2].buffer = &totals.averageFuel;
+
+    if (mysql_stmt_bind_result(stmt, result_bind) != 0) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return totals;
+    }
+
+    if (db->fetch(stmt) != 0) {
+        totals = CalculationTotals();
+    }
+
+    db->finish(stmt);
+    return totals;
+}
+
+std::vector<std::string> MySqlStorage::calculationUsers() {
+    std::vector<std::string> users;
+    MYSQL* conn = db->getConnection();
+    if (!conn) {
+        std::cerr << "Database connection not available.\n";
+        return users;
+    }
+
+    MYSQL_RES* result = db->queryResult("SELECT DISTINCT username FROM calculation_history ORDER BY username");
+    if (!result) {
+        std::cerr << "Failed to list users: " << mysql_error(conn) << std::endl;
+        return users;
+    }
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result))) {
+        if (row[0]) users.push_back(row[0]);
+    }
+    mysql_free_result(result);
+    return users;
+}
+
+bool MySqlStorage::scanCalculations(const std::string& username,
+    const std::function<void(const CalculationRecord&)>& visit) {
+    // Export workers scan in parallel, each on its own pooled connection;
+    // the lease also binds it for prepare() on this thread
+    DatabaseManager::Lease lease = db->acquire();
+    if (!lease) {
+        return false;
+    }
+
+    // Rows stream from the server as they are fetched (the result is never
+    // stored client-side), so any number of rows is visited in constant memory
+    std::string sql = std::string("SELECT ") + RECORD_COLUMNS + " FROM calculation_history" +
+        (username.empty() ? "" : " WHERE username = ?") + " ORDER BY id";
+
+    MYSQL_STMT* stmt = db->prepare(sql);
+    if (!stmt) {
+        return false;
+    }
+
+    if (!username.empty()) {
+        MYSQL_BIND bind[1];
+        memset(bind, 0, sizeof(bind));
+        bindString(bind[0], username);
+
+        if (mysql_stmt_bind_param(stmt, bind) != 0) {
+            std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
+            db->finish(stmt);
+            return false;
+        }
+    }
+
+    if (!db->execute(stmt)) {
+        std::cerr << "Failed to execute query: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    RecordBuffers row;
+    if (mysql_stmt_bind_result(stmt, row.bind) != 0) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
+        db->finish(stmt);
+        return false;
+    }
+
+    CalculationRecord record = {};
+    int status;
+    while ((status = db->fetch(stmt)) == 0 || status == MYSQL_DATA_TRUNCATED) {
+        row.fill(stmt, record);
+        visit(record);
+    }
+
+    bool complete = (status == MYSQL_NO_DATA);
+    if (!complete) {
+        std::cerr << "Scan interrupted: " << mysql_stmt_error(stmt) << std::endl;
+    }
+    db->finish(stmt);
+    return complete;
+}
+
+std::vector<CalculationRecord> MySqlStorage::fetchRecords(MYSQL_STMT* stmt) {
+    std::vector<CalculationRecord> records;
+    RecordBuffers buffers;
+
+    if (mysql_stmt_bind_result(stmt, buffers.bind) != 0) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(stmt) << std::endl;
+        return records;
+    }
+
+    int status;
+    while ((status = db->fetch(stmt)) == 0 || status == MYSQL_DATA_TRUNCATED) {
+        records.emplace_back();
+        buffers.fill(stmt, records.back());
+    }
+    if (status == 1) {
+        std::cerr << "Failed to fetch results: " << mysql_stmt_error(stmt) << std::endl;
+    }
+    return records;
+}
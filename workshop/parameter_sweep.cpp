@@ -0,0 +1,169 @@
+#include "Parameter_Sweep.h"
+#include "Thread_Pool.h"
+#include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <charconv>
+#include <memory>
+
+size_t SweepSpec::pointCount() const {
+    size_t total = 1;
+    for (const SweepRange& r : axes) total *= r.steps;
+    return total;
+}
+
+size_t SweepResult::flatIndex(const size_t coords[SWEEP_AXES]) const {
+    size_t flat = 0;
+    for (int a = 0; a < SWEEP_AXES; ++a) {
+        flat = flat * spec.axes[a].steps + coords[a];
+    }
+    return flat;
+}
+
+void SweepResult::coordinates(size_t flat, size_t coords[SWEEP_AXES]) const {
+    for (int a = SWEEP_AXES - 1; a >= 0; --a) {
+        coords[a] = flat % spec.axes[a].steps;
+        flat /= spec.axes[a].steps;
+    }
+}
+
+bool SweepResult::writeCSV(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+
+    file << "tire_pressure_bar,temperature_c,roughness,gradient,speed_kmh,fuel_liters\n";
+
+    // Format into a large buffer; ostream formatting dominates at 10^7 rows
+    std::vector<char> buffer(1 << 20);
+    size_t used = 0;
+    size_t coords[SWEEP_AXES];
+
+    for (size_t i = 0; i < liters.size(); ++i) {
+        if (buffer.size() - used < 256) {
+            file.write(buffer.data(), used);
+            used = 0;
+        }
+
+        coordinates(i, coords);
+        char* p = buffer.data() + used;
+        char* end = buffer.data() + buffer.size();
+        for (int a = 0; a < SWEEP_AXES; ++a) {
+            p = std::to_chars(p, end, spec.axes[a].at(coords[a])).ptr;
+            *p++ = ',';
+        }
+        p = std::to_chars(p, end, liters[i]).ptr;
+        *p++ = '\n';
+        used = p - buffer.data();
+    }
+    file.write(buffer.data(), used);
+
+    if (!file) {
+        std::cerr << "Failed to write file: " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool SweepResult::writeBinary(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+
+    const char magic[4] = { 'F', 'S', 'W', 'P' };
+    uint32_t version = 1;
+    uint32_t axisCount = SWEEP_AXES;
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&axisCount), sizeof(axisCount));
+
+    for (const SweepRange& r : spec.axes) {
+        uint64_t steps = r.steps;
+        file.write(reinterpret_cast<const char*>(&r.start), sizeof(r.start));
+        file.write(reinterpret_cast<const char*>(&r.stop), sizeof(r.stop));
+        file.write(reinterpret_cast<const char*>(&steps), sizeof(steps));
+    }
+    file.write(reinterpret_cast<const char*>(&spec.distanceKm), sizeof(spec.distanceKm));
+    file.write(reinterpret_cast<const char*>(liters.data()), liters.size() * sizeof(double));
+
+    if (!file) {
+        std::cerr << "Failed to write file: " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+ParameterSweep::ParameterSweep(ThreadPool& pool) : pool(pool) {}
+
+SweepResult ParameterSweep::run(const Vehicle& veh, const SweepSpec& spec) {
+    SweepResult result;
+    result.spec = spec;
+    result.liters.resize(spec.pointCount());
+
+    const size_t chunk = 4096;
+
+    // Each worker owns one set of SoA buffers for the lifetime of the sweep
+    struct Buffers {
+        std::vector<double> mass, cd, area, tire, power, grad, rough, temp, press, dist, speed;
+    };
+    std::vector<Buffers> perWorker(pool.size());
+    for (Buffers& b : perWorker) {
+        b.mass.assign(chunk, veh.massKg);
+        b.cd.assign(chunk, veh.dragCoef);
+        b.area.assign(chunk, veh.frontalArea);
+        b.power.assign(chunk, veh.engineRatedPower);
+        b.press.assign(chunk, spec.pressurePa);
+        b.dist.assign(chunk, spec.distanceKm);
+        b.tire.resize(chunk);
+        b.grad.resize(chunk);
+        b.rough.resize(chunk);
+        b.temp.resize(chunk);
+        b.speed.resize(chunk);
+    }
+    // std::vector<bool> has no data(), so the AC flags use a plain array
+    std::unique_ptr<bool[]> acFlags(new bool[chunk]);
+    for (size_t i = 0; i < chunk; ++i) acFlags[i] = veh.hasAC;
+
+    pool.parallelFor(result.liters.size(), chunk, [&](size_t begin, size_t end, size_t worker) {
+        Buffers& b = perWorker[worker];
+        size_t coords[SWEEP_AXES];
+        result.coordinates(begin, coords);
+
+        for (size_t i = 0; i < end - begin; ++i) {
+            b.tire[i] = spec.axes[AXIS_TIRE_PRESSURE].at(coords[AXIS_TIRE_PRESSURE]);
+            b.temp[i] = spec.axes[AXIS_TEMPERATURE].at(coords[AXIS_TEMPERATURE]);
+            b.rough[i] = spec.axes[AXIS_ROUGHNESS].at(coords[AXIS_ROUGHNESS]);
+            b.grad[i] = spec.axes[AXIS_GRADIENT].at(coords[AXIS_GRADIENT]);
+            b.speed[i] = spec.axes[AXIS_SPEED].at(coords[AXIS_SPEED]);
+
+            // Odometer-style increment, innermost axis first
+            for (int a = SWEEP_AXES - 1; a >= 0; --a) {
+                if (++coords[a] < spec.axes[a].steps) break;
+                coords[a] = 0;
+            }
+        }
+
+        MissionBatch batch;
+        batch.count = end - begin;
+        batch.massKg = b.mass.data();
+        batch.dragCoef = b.cd.data();
+        batch.frontalArea = b.area.data();
+        batch.tirePressureBar = b.tire.data();
+        batch.engineRatedPower = b.power.data();
+        batch.hasAC = acFlags.get();
+        batch.roadGradient = b.grad.data();
+        batch.surfaceRoughness = b.rough.data();
+        batch.ambientTempC = b.temp.data();
+        batch.pressurePa = b.press.data();
+        batch.distanceKm = b.dist.data();
+        batch.avgSpeedKmh = b.speed.data();
+
+        calculator.calculateBatch(batch, result.liters.data() + begin, spec.precision);
+    });
+
+    return result;
+}
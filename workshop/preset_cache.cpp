@@ -0,0 +1,124 @@
+#include "Preset_Cache.h"
+#include <iostream>
+#include <iomanip>
+
+PresetCache::PresetCache(size_t capacity) : maxEntries(capacity > 0 ? capacity : 1) {}
+
+PresetCache::Lookup PresetCache::find(const std::string& name, MissionPreset& out) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = index.find(name);
+    if (it != index.end()) {
+        // Move to the front of the LRU list
+        lru.splice(lru.begin(), lru, it->second);
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        if (!it->second->present) return Lookup::ABSENT;
+        out = it->second->preset;
+        return Lookup::FOUND;
+    }
+
+    // A current listing holds every preset there is, under its stored name.
+    // The store matches names by its collation, not byte for byte, so a
+    // name the listing lacks may still be found there and is a miss.
+    if (listingVersion == currentVersion) {
+        for (const MissionPreset& preset : presets) {
+            if (preset.name == name) {
+                hitCount.fetch_add(1, std::memory_order_relaxed);
+                out = preset;
+                return Lookup::FOUND;
+            }
+        }
+    }
+
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return Lookup::MISS;
+}
+
+void PresetCache::store(const MissionPreset& preset, bool present, uint64_t readAtVersion) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    // Something was invalidated while the store was being read
+    if (readAtVersion != currentVersion) return;
+
+    auto it = index.find(preset.name);
+    if (it != index.end()) {
+        it->second->preset = preset;
+        it->second->present = present;
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    lru.push_front({ preset, present });
+    index.emplace(preset.name, lru.begin());
+
+    if (lru.size() > maxEntries) {
+        index.erase(lru.back().preset.name);
+        lru.pop_back();
+    }
+}
+
+void PresetCache::storeFound(const MissionPreset& preset, uint64_t readAtVersion) {
+    store(preset, true, readAtVersion);
+}
+
+void PresetCache::storeAbsent(const std::string& name, uint64_t readAtVersion) {
+    MissionPreset absent;
+    absent.name = name;
+    store(absent, false, readAtVersion);
+}
+
+uint64_t PresetCache::version() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return currentVersion;
+}
+
+bool PresetCache::listing(std::vector<MissionPreset>& out) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (listingVersion != currentVersion) return false;
+    out = presets;
+    listingHits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PresetCache::storeListing(std::vector<MissionPreset> list, uint64_t readAtVersion) {
+    std::lock_guard<std::mutex> guard(lock);
+    listingReads.fetch_add(1, std::memory_order_relaxed);
+
+    if (readAtVersion != currentVersion) return;
+    presets = std::move(list);
+    listingVersion = currentVersion;
+}
+
+void PresetCache::invalidate() {
+    std::lock_guard<std::mutex> guard(lock);
+    ++currentVersion;
+    index.clear();
+    lru.clear();
+}
+
+void PresetCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    ++currentVersion;
+    index.clear();
+    lru.clear();
+    presets.clear();
+}
+
+size_t PresetCache::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return lru.size();
+}
+
+void PresetCache::displayStats() const {
+    uint64_t h = hits();
+    uint64_t m = misses();
+    double rate = (h + m) > 0 ? 100.0 * static_cast<double>(h) / static_cast<double>(h + m) : 0.0;
+
+    std::cout << "\n--- Preset Cache ---\n";
+    std::cout << "Entries:  " << size() << " / " << capacity() << "\n";
+    std::cout << "Hits:     " << h << "\n";
+    std::cout << "Misses:   " << m << "\n";
+    std::cout << "Hit Rate: " << std::fixed << std::setprecision(1) << rate << "%\n";
+    std::cout << "Listings: " << listingHits.load(std::memory_order_relaxed) << " cached, "
+        << listingReads.load(std::memory_order_relaxed) << " read from storage\n";
+}
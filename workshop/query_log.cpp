@@ -0,0 +1,185 @@
+#include "Query_Log.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+    int bucketOf(std::chrono::nanoseconds elapsed) {
+        uint64_t us = (uint64_t)(std::max)(elapsed.count(), int64_t(0)) / 1000;
+        int bucket = 0;
+        while (us > 1 && bucket < QueryLog::BUCKETS - 1) {
+            us >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // Upper edge of the bucket that holds the given fraction of calls
+    double percentileMs(const uint64_t* counts, uint64_t calls, double fraction) {
+        if (calls == 0) return 0.0;
+        uint64_t rank = (uint64_t)(fraction * (double)calls);
+        if (rank >= calls) rank = calls - 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < QueryLog::BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen > rank) {
+                return (double)(uint64_t(2) << i) / 1000.0;
+            }
+        }
+        return (double)(uint64_t(1) << QueryLog::BUCKETS) / 1000.0;
+    }
+
+    std::string currentTimestamp() {
+        std::time_t now = std::time(nullptr);
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        char text[20];
+        std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        return text;
+    }
+
+}
+
+QueryLog::QueryLog() : slowThresholdNs(0) {}
+
+QueryLog::Entry* QueryLog::entry(const std::string& sql) {
+    std::lock_guard<std::mutex> guard(lock);
+    std::unique_ptr<Entry>& slot = entries[sql];
+    if (!slot) {
+        slot.reset(new Entry(sql));
+    }
+    return slot.get();
+}
+
+void QueryLog::record(Entry* entry, std::chrono::nanoseconds elapsed, uint64_t rows, uint32_t roundTrips, bool ok) {
+    uint64_t ns = (uint64_t)(std::max)(elapsed.count(), int64_t(0));
+    entry->calls.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) entry->errors.fetch_add(1, std::memory_order_relaxed);
+    if (rows) entry->rows.fetch_add(rows, std::memory_order_relaxed);
+    entry->roundTrips.fetch_add(roundTrips, std::memory_order_relaxed);
+    entry->totalNs.fetch_add(ns, std::memory_order_relaxed);
+    entry->buckets[bucketOf(elapsed)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = entry->maxNs.load(std::memory_order_relaxed);
+    while (ns > seen && !entry->maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void QueryLog::addRows(Entry* entry, uint64_t rows) {
+    if (rows) entry->rows.fetch_add(rows, std::memory_order_relaxed);
+}
+
+void QueryLog::addRoundTrips(Entry* entry, uint32_t roundTrips) {
+    entry->roundTrips.fetch_add(roundTrips, std::memory_order_relaxed);
+}
+
+void QueryLog::setSlowQueryLog(const std::string& path, std::chrono::milliseconds threshold) {
+    std::lock_guard<std::mutex> guard(slowLock);
+    if (slowLog.is_open()) slowLog.close();
+    slowLogPath = path;
+
+    bool enabled = !path.empty() && threshold.count() > 0;
+    if (enabled) {
+        slowLog.open(path, std::ios::app);
+        if (!slowLog.is_open()) {
+            std::cerr << "Failed to open slow query log: " << path << "\n";
+            enabled = false;
+        }
+    }
+    slowThresholdNs.store(enabled ? std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count() : 0,
+        std::memory_order_relaxed);
+}
+
+void QueryLog::logSlow(const Entry* entry, std::chrono::nanoseconds elapsed, uint64_t rows) {
+    std::lock_guard<std::mutex> guard(slowLock);
+    if (!slowLog.is_open()) return;
+
+    // One line per statement: when, how long, how many rows, what
+    std::string sql = entry->sql;
+    std::replace(sql.begin(), sql.end(), '\n', ' ');
+    slowLog << currentTimestamp() << '\t'
+        << std::fixed << std::setprecision(3) << elapsed.count() / 1e6 << " ms\t"
+        << rows << " rows\t" << sql << '\n';
+    slowLog.flush();
+}
+
+std::vector<QueryLog::Summary> QueryLog::summaries() const {
+    std::vector<Summary> list;
+    std::lock_guard<std::mutex> guard(lock);
+    list.reserve(entries.size());
+
+    for (const auto& item : entries) {
+        const Entry& e = *item.second;
+        uint64_t counts[BUCKETS];
+        for (int i = 0; i < BUCKETS; ++i) {
+            counts[i] = e.buckets[i].load(std::memory_order_relaxed);
+        }
+
+        Summary s;
+        s.sql = e.sql;
+        s.calls = e.calls.load(std::memory_order_relaxed);
+        if (s.calls == 0) continue;
+        s.errors = e.errors.load(std::memory_order_relaxed);
+        s.rows = e.rows.load(std::memory_order_relaxed);
+        s.roundTrips = e.roundTrips.load(std::memory_order_relaxed);
+        s.totalMs = e.totalNs.load(std::memory_order_relaxed) / 1e6;
+        s.meanMs = s.totalMs / s.calls;
+        s.p50Ms = percentileMs(counts, s.calls, 0.50);
+        s.p95Ms = percentileMs(counts, s.calls, 0.95);
+        s.p99Ms = percentileMs(counts, s.calls, 0.99);
+        s.maxMs = e.maxNs.load(std::memory_order_relaxed) / 1e6;
+        list.push_back(s);
+    }
+
+    std::sort(list.begin(), list.end(), [](const Summary& a, const Summary& b) {
+        return a.totalMs > b.totalMs;
+    });
+    return list;
+}
+
+void QueryLog::display(size_t top) const {
+    std::vector<Summary> list = summaries();
+
+    uint64_t calls = 0, roundTrips = 0, errors = 0;
+    double totalMs = 0.0;
+    for (const Summary& s : list) {
+        calls += s.calls;
+        roundTrips += s.roundTrips;
+        errors += s.errors;
+        totalMs += s.totalMs;
+    }
+
+    std::cout << "\n--- Query Statistics ---\n";
+    std::cout << "Statements: " << list.size() << " | Calls: " << calls << " | Round trips: " << roundTrips
+        << " | Errors: " << errors << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Total time: " << totalMs << " ms\n";
+    {
+        std::lock_guard<std::mutex> guard(slowLock);
+        if (slowThresholdNs.load(std::memory_order_relaxed) > 0) {
+            std::cout << "Slow query log: " << slowLogPath << " (>= "
+                << slowThresholdNs.load(std::memory_order_relaxed) / 1e6 << " ms)\n";
+        }
+    }
+    if (list.empty()) return;
+
+    std::cout << std::left << std::setw(8) << "Calls" << std::setw(9) << "Rows" << std::setw(7) << "RTs"
+        << std::right << std::setw(11) << "Total ms" << std::setw(10) << "Mean" << std::setw(10) << "p95"
+        << std::setw(10) << "Max" << "  Statement\n";
+    for (size_t i = 0; i < list.size() && i < top; ++i) {
+        const Summary& s = list[i];
+        std::string sql = s.sql.size() > 60 ? s.sql.substr(0, 57) + "..." : s.sql;
+        std::cout << std::left << std::setw(8) << s.calls << std::setw(9) << s.rows << std::setw(7) << s.roundTrips
+            << std::right << std::setw(11) << s.totalMs << std::setw(10) << s.meanMs << std::setw(10) << s.p95Ms
+            << std::setw(10) << s.maxMs << "  " << sql << "\n";
+    }
+    if (list.size() > top) {
+        std::cout << "(" << list.size() - top << " more)\n";
+    }
+}
@@ -0,0 +1,504 @@
+#include "Reference_Snapshot.h"
+#include "Environment.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// ---- File layout ------------------------------------------------------------
+//
+// [Header][VehicleRecord x n][PresetRecord x n][EnvironmentRecord x n][strings]
+//
+// Every section starts on an 8-byte boundary. Field sizes are fixed, so the
+// records can be read straight out of the mapping.
+
+struct ReferenceSnapshot::Header {
+    char magic[8];              // "FUELREF\0"
+    uint32_t byteOrder;         // BYTE_ORDER_MARK as the writer stored it
+    uint32_t formatVersion;
+    uint32_t headerSize;
+    uint32_t hasFuelPrice;
+    uint64_t fileSize;
+    uint64_t generation;
+    int64_t createdAt;
+    uint64_t checksum;          // FNV-1a of bytes [headerSize, fileSize)
+    double fuelPrice;
+    uint64_t vehicleOffset;
+    uint64_t vehicleCount;
+    uint64_t presetOffset;
+    uint64_t presetCount;
+    uint64_t environmentOffset;
+    uint64_t environmentCount;
+    uint64_t stringOffset;
+    uint64_t stringSize;
+};
+
+// A string in the pool
+struct ReferenceSnapshot::Text {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct ReferenceSnapshot::VehicleRecord {
+    Text id;
+    Text model;
+    double efficiency;
+    double massKg;
+    double dragCoef;
+    double frontalArea;
+    double engineRatedPower;
+    double tirePressureBar;
+    uint32_t hasAC;
+    uint32_t reserved;
+};
+
+struct ReferenceSnapshot::PresetRecord {
+    Text name;
+    double gradient;
+    double roughness;
+    double temperature;
+};
+
+struct ReferenceSnapshot::EnvironmentRecord {
+    Text terrain;
+    Text climate;
+    double gradient;
+    double roughness;
+    double temperature;
+    double pressure;
+};
+
+namespace {
+
+    const char MAGIC[8] = { 'F', 'U', 'E', 'L', 'R', 'E', 'F', '\0' };
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    uint64_t fnv1a(const char* data, size_t length) {
+        uint64_t h = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; ++i) {
+            h ^= (unsigned char)data[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    void alignTo8(std::string& out) {
+        out.resize((out.size() + 7) & ~size_t(7), '\0');
+    }
+
+    template <typename T>
+    T* recordAt(std::string& out, size_t offset) {
+        return reinterpret_cast<T*>(&out[offset]);
+    }
+
+}
+
+ReferenceSnapshot::ReferenceSnapshot() : base(nullptr), size(0) {
+    static_assert(sizeof(Header) == 128, "snapshot header layout changed");
+    static_assert(sizeof(VehicleRecord) == 72, "snapshot vehicle layout changed");
+    static_assert(sizeof(PresetRecord) == 32, "snapshot preset layout changed");
+    static_assert(sizeof(EnvironmentRecord) == 48, "snapshot environment layout changed");
+}
+
+ReferenceSnapshot::~ReferenceSnapshot() {
+    close();
+}
+
+bool ReferenceSnapshot::collect(Storage* storage, ReferenceData& out) {
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
+        return false;
+    }
+    if (!storage->loadAllVehicles(out.vehicles) || !storage->listPresets(out.presets)
+        || !storage->listEnvironments(out.environments)) {
+        std::cerr << "Could not read the reference data from " << storage->backendName() << ".\n";
+        return false;
+    }
+    out.hasFuelPrice = storage->loadFuelPrice(out.fuelPrice);
+    return true;
+}
+
+bool ReferenceSnapshot::write(const std::string& path, const ReferenceData& data, uint64_t generation) {
+    std::string strings;
+    auto addText = [&strings](const std::string& value) {
+        Text t;
+        t.offset = (uint32_t)strings.size();
+        t.length = (uint32_t)value.size();
+        strings += value;
+        return t;
+    };
+
+    // Lookups binary-search these two
+    std::vector<size_t> vehicleOrder(data.vehicles.size());
+    std::iota(vehicleOrder.begin(), vehicleOrder.end(), size_t(0));
+    std::sort(vehicleOrder.begin(), vehicleOrder.end(), [&data](size_t a, size_t b) {
+        return data.vehicles[a].vehicle_id < data.vehicles[b].vehicle_id;
+    });
+    std::vector<size_t> presetOrder(data.presets.size());
+    std::iota(presetOrder.begin(), presetOrder.end(), size_t(0));
+    std::sort(presetOrder.begin(), presetOrder.end(), [&data](size_t a, size_t b) {
+        return data.presets[a].name < data.presets[b].name;
+    });
+
+    std::string out(sizeof(Header), '\0');
+
+    size_t vehicleOffset = out.size();
+    out.resize(vehicleOffset + data.vehicles.size() * sizeof(VehicleRecord), '\0');
+    for (size_t i = 0; i < vehicleOrder.size(); ++i) {
+        const Vehicle& v = data.vehicles[vehicleOrder[i]];
+        VehicleRecord* r = recordAt<VehicleRecord>(out, vehicleOffset + i * sizeof(VehicleRecord));
+        r->id = addText(v.vehicle_id);
+        r->model = addText(v.model_name);
+        r->efficiency = v.efficiency;
+        r->massKg = v.massKg;
+        r->dragCoef = v.dragCoef;
+        r->frontalArea = v.frontalArea;
+        r->engineRatedPower = v.engineRatedPower;
+        r->tirePressureBar = v.tirePressureBar;
+        r->hasAC = v.hasAC ? 1 : 0;
+    }
+
+    size_t presetOffset = out.size();
+    out.resize(presetOffset + data.presets.size() * sizeof(PresetRecord), '\0');
+    for (size_t i = 0; i < presetOrder.size(); ++i) {
+        const MissionPreset& p = data.presets[presetOrder[i]];
+        PresetRecord* r = recordAt<PresetRecord>(out, presetOffset + i * sizeof(PresetRecord));
+        r->name = addText(p.name);
+        r->gradient = p.roadGradient;
+        r->roughness = p.surfaceRoughness;
+        r->temperature = p.ambientTempC;
+    }
+
+    size_t environmentOffset = out.size();
+    out.resize(environmentOffset + data.environments.size() * sizeof(EnvironmentRecord), '\0');
+    for (size_t i = 0; i < data.environments.size(); ++i) {
+        const EnvironmentPreset& e = data.environments[i];
+        EnvironmentRecord* r = recordAt<EnvironmentRecord>(out, environmentOffset + i * sizeof(EnvironmentRecord));
+        r->terrain = addText(e.terrain);
+        r->climate = addText(e.climate);
+        r->gradient = e.gradient;
+        r->roughness = e.roughness;
+        r->temperature = e.temperature;
+        r->pressure = e.pressure;
+    }
+
+    if (strings.size() > UINT32_MAX) {
+        std::cerr << "Reference data too large for a snapshot.\n";
+        return false;
+    }
+    size_t stringOffset = out.size();
+    out += strings;
+    alignTo8(out);
+
+    Header* h = recordAt<Header>(out, 0);
+    std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+    h->byteOrder = BYTE_ORDER_MARK;
+    h->formatVersion = FORMAT_VERSION;
+    h->headerSize = sizeof(Header);
+    h->hasFuelPrice = data.hasFuelPrice ? 1 : 0;
+    h->fileSize = out.size();
+    h->generation = generation;
+    h->createdAt = (int64_t)std::time(nullptr);
+    h->fuelPrice = data.hasFuelPrice ? data.fuelPrice : 0.0;
+    h->vehicleOffset = vehicleOffset;
+    h->vehicleCount = data.vehicles.size();
+    h->presetOffset = presetOffset;
+    h->presetCount = data.presets.size();
+    h->environmentOffset = environmentOffset;
+    h->environmentCount = data.environments.size();
+    h->stringOffset = stringOffset;
+    h->stringSize = strings.size();
+    h->checksum = fnv1a(out.data() + sizeof(Header), out.size() - sizeof(Header));
+
+    // Readers see the old file or the new one, never a partial write
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(out.data(), (std::streamsize)out.size());
+        file.flush();
+        if (!file) {
+            std::cerr << "Failed to write " << temporary << "\n";
+            return false;
+        }
+    }
+    std::error_code error;
+    fs::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to replace " << path << ": " << error.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool ReferenceSnapshot::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart < (LONGLONG)sizeof(Header)) {
+        CloseHandle(file);
+        std::cerr << "Reference snapshot " << path << " is truncated.\n";
+        return false;
+    }
+    // The view keeps the mapping alive once both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        std::cerr << "Failed to map " << path << "\n";
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        std::cerr << "Failed to map " << path << "\n";
+        return false;
+    }
+    base = static_cast<const char*>(view);
+    size = (size_t)length.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+        ::close(fd);
+        std::cerr << "Reference snapshot " << path << " is truncated.\n";
+        return false;
+    }
+    // The mapping outlives the descriptor
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map " << path << "\n";
+        return false;
+    }
+    base = static_cast<const char*>(view);
+    size = (size_t)info.st_size;
+#endif
+
+    if (!validate(path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ReferenceSnapshot::close() {
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+#else
+    munmap(const_cast<char*>(base), size);
+#endif
+    base = nullptr;
+    size = 0;
+}
+
+bool ReferenceSnapshot::validate(const std::string& path) const {
+    const Header& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << path << " is not a reference snapshot.\n";
+        return false;
+    }
+    if (h.byteOrder != BYTE_ORDER_MARK) {
+        std::cerr << "Reference snapshot " << path << " was written with the other byte order.\n";
+        return false;
+    }
+    if (h.formatVersion != FORMAT_VERSION || h.headerSize != sizeof(Header)) {
+        std::cerr << "Reference snapshot " << path << " has format version " << h.formatVersion
+            << ", expected " << FORMAT_VERSION << ".\n";
+        return false;
+    }
+    if (h.fileSize != size) {
+        std::cerr << "Reference snapshot " << path << " is truncated.\n";
+        return false;
+    }
+
+    auto fits = [this](uint64_t offset, uint64_t count, size_t width) {
+        return offset % 8 == 0 && offset >= sizeof(Header) && offset <= size
+            && count <= (size - offset) / width;
+    };
+    if (!fits(h.vehicleOffset, h.vehicleCount, sizeof(VehicleRecord))
+        || !fits(h.presetOffset, h.presetCount, sizeof(PresetRecord))
+        || !fits(h.environmentOffset, h.environmentCount, sizeof(EnvironmentRecord))
+        || !fits(h.stringOffset, h.stringSize, 1)) {
+        std::cerr << "Reference snapshot " << path << " has a damaged section table.\n";
+        return false;
+    }
+
+    if (fnv1a(base + sizeof(Header), size - sizeof(Header)) != h.checksum) {
+        std::cerr << "Reference snapshot " << path << " failed its checksum.\n";
+        return false;
+    }
+
+    // Every string must lie inside the pool, so lookups need no bounds checks
+    auto inPool = [&h](const Text& t) {
+        return (uint64_t)t.offset + t.length <= h.stringSize;
+    };
+    bool ok = true;
+    for (size_t i = 0; ok && i < h.vehicleCount; ++i) {
+        ok = inPool(vehicleRecords()[i].id) && inPool(vehicleRecords()[i].model);
+    }
+    for (size_t i = 0; ok && i < h.presetCount; ++i) {
+        ok = inPool(presetRecords()[i].name);
+    }
+    for (size_t i = 0; ok && i < h.environmentCount; ++i) {
+        ok = inPool(environmentRecords()[i].terrain) && inPool(environmentRecords()[i].climate);
+    }
+    if (!ok) {
+        std::cerr << "Reference snapshot " << path << " has a string outside its pool.\n";
+    }
+    return ok;
+}
+
+const ReferenceSnapshot::Header& ReferenceSnapshot::header() const {
+    return *reinterpret_cast<const Header*>(base);
+}
+
+const ReferenceSnapshot::VehicleRecord* ReferenceSnapshot::vehicleRecords() const {
+    return reinterpret_cast<const VehicleRecord*>(base + header().vehicleOffset);
+}
+
+const ReferenceSnapshot::PresetRecord* ReferenceSnapshot::presetRecords() const {
+    return reinterpret_cast<const PresetRecord*>(base + header().presetOffset);
+}
+
+const ReferenceSnapshot::EnvironmentRecord* ReferenceSnapshot::environmentRecords() const {
+    return reinterpret_cast<const EnvironmentRecord*>(base + header().environmentOffset);
+}
+
+std::string_view ReferenceSnapshot::text(const Text& t) const {
+    return std::string_view(base + header().stringOffset + t.offset, t.length);
+}
+
+uint64_t ReferenceSnapshot::generation() const {
+    return base ? header().generation : 0;
+}
+
+int64_t ReferenceSnapshot::createdAt() const {
+    return base ? header().createdAt : 0;
+}
+
+size_t ReferenceSnapshot::vehicleCount() const {
+    return base ? (size_t)header().vehicleCount : 0;
+}
+
+void ReferenceSnapshot::fillVehicle(const VehicleRecord& record, Vehicle& out) const {
+    out.vehicle_id.assign(text(record.id));
+    out.model_name.assign(text(record.model));
+    out.efficiency = record.efficiency;
+    out.massKg = record.massKg;
+    out.dragCoef = record.dragCoef;
+    out.frontalArea = record.frontalArea;
+    out.engineRatedPower = record.engineRatedPower;
+    out.tirePressureBar = record.tirePressureBar;
+    out.hasAC = record.hasAC != 0;
+}
+
+bool ReferenceSnapshot::findVehicle(const std::string& id, Vehicle& out) const {
+    if (!base) return false;
+    const VehicleRecord* first = vehicleRecords();
+    const VehicleRecord* last = first + header().vehicleCount;
+    const VehicleRecord* at = std::lower_bound(first, last, id, [this](const VehicleRecord& r, const std::string& key) {
+        return text(r.id) < key;
+    });
+    if (at == last || text(at->id) != id) return false;
+    fillVehicle(*at, out);
+    return true;
+}
+
+std::vector<Vehicle> ReferenceSnapshot::vehicles(Storage* owner) const {
+    std::vector<Vehicle> all;
+    all.reserve(vehicleCount());
+    for (size_t i = 0; i < vehicleCount(); ++i) {
+        all.emplace_back(owner);
+        fillVehicle(vehicleRecords()[i], all.back());
+    }
+    return all;
+}
+
+size_t ReferenceSnapshot::presetCount() const {
+    return base ? (size_t)header().presetCount : 0;
+}
+
+bool ReferenceSnapshot::findPreset(const std::string& name, MissionPreset& out) const {
+    if (!base) return false;
+    const PresetRecord* first = presetRecords();
+    const PresetRecord* last = first + header().presetCount;
+    const PresetRecord* at = std::lower_bound(first, last, name, [this](const PresetRecord& r, const std::string& key) {
+        return text(r.name) < key;
+    });
+    if (at == last || text(at->name) != name) return false;
+    out.name = name;
+    out.roadGradient = at->gradient;
+    out.surfaceRoughness = at->roughness;
+    out.ambientTempC = at->temperature;
+    return true;
+}
+
+std::vector<MissionPreset> ReferenceSnapshot::presets() const {
+    std::vector<MissionPreset> all(presetCount());
+    for (size_t i = 0; i < all.size(); ++i) {
+        const PresetRecord& r = presetRecords()[i];
+        all[i].name.assign(text(r.name));
+        all[i].roadGradient = r.gradient;
+        all[i].surfaceRoughness = r.roughness;
+        all[i].ambientTempC = r.temperature;
+    }
+    return all;
+}
+
+bool ReferenceSnapshot::findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) const {
+    if (!base) return false;
+    for (size_t i = 0; i < header().environmentCount; ++i) {
+        const EnvironmentRecord& r = environmentRecords()[i];
+        if (text(r.terrain) == terrain || text(r.climate) == climate) {
+            out.roadGradient = r.gradient;
+            out.surfaceRoughness = r.roughness;
+            out.ambientTempC = r.temperature;
+            out.pressurePa = r.pressure;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<EnvironmentPreset> ReferenceSnapshot::environments() const {
+    std::vector<EnvironmentPreset> all(base ? (size_t)header().environmentCount : 0);
+    for (size_t i = 0; i < all.size(); ++i) {
+        const EnvironmentRecord& r = environmentRecords()[i];
+        all[i].terrain.assign(text(r.terrain));
+        all[i].climate.assign(text(r.climate));
+        all[i].gradient = r.gradient;
+        all[i].roughness = r.roughness;
+        all[i].temperature = r.temperature;
+        all[i].pressure = r.pressure;
+    }
+    return all;
+}
+
+bool ReferenceSnapshot::fuelPrice(double& price) const {
+    if (!base || !header().hasFuelPrice) return false;
+    price = header().fuelPrice;
+    return true;
+}
@@ -0,0 +1,134 @@
+#include "Result_Cache.h"
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+
+    int64_t quantize(double value, double step) {
+        return static_cast<int64_t>(std::llround(value / step));
+    }
+
+}
+
+bool ResultCache::Key::operator==(const Key& other) const {
+    for (int i = 0; i < 5; ++i) {
+        if (quantized[i] != other.quantized[i]) return false;
+    }
+    return vehicleId == other.vehicleId && presetName == other.presetName;
+}
+
+size_t ResultCache::KeyHash::operator()(const Key& key) const {
+    size_t h = std::hash<std::string>()(key.vehicleId);
+    h ^= std::hash<std::string>()(key.presetName) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    for (int64_t q : key.quantized) {
+        h ^= std::hash<int64_t>()(q) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+}
+
+ResultCache::ResultCache(size_t capacity) : maxEntries(capacity > 0 ? capacity : 1) {}
+
+ResultCache::Key ResultCache::manualKey(const std::string& vehicleId, double gradient, double roughness,
+    double temperatureC, double distanceKm, double speedKmh) {
+    Key key;
+    key.vehicleId = vehicleId;
+    key.quantized[0] = quantize(gradient, GRADIENT_STEP);
+    key.quantized[1] = quantize(roughness, ROUGHNESS_STEP);
+    key.quantized[2] = quantize(temperatureC, TEMPERATURE_STEP);
+    key.quantized[3] = quantize(distanceKm, DISTANCE_STEP);
+    key.quantized[4] = quantize(speedKmh, SPEED_STEP);
+    return key;
+}
+
+ResultCache::Key ResultCache::presetKey(const std::string& vehicleId, const std::string& presetName,
+    double distanceKm, double speedKmh) {
+    Key key;
+    key.vehicleId = vehicleId;
+    key.presetName = presetName;
+    key.quantized[3] = quantize(distanceKm, DISTANCE_STEP);
+    key.quantized[4] = quantize(speedKmh, SPEED_STEP);
+    return key;
+}
+
+bool ResultCache::find(const Key& key, Entry& out) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Move to the front of the LRU list
+    lru.splice(lru.begin(), lru, it->second);
+    out = it->second->second;
+    hitCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ResultCache::store(const Key& key, const Entry& entry) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = entry;
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    lru.emplace_front(key, entry);
+    index.emplace(key, lru.begin());
+
+    if (lru.size() > maxEntries) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+    }
+}
+
+template <typename Pred>
+void ResultCache::eraseIf(Pred pred) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    for (auto it = lru.begin(); it != lru.end();) {
+        if (pred(it->first)) {
+            index.erase(it->first);
+            it = lru.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void ResultCache::invalidateVehicle(const std::string& vehicleId) {
+    eraseIf([&](const Key& key) { return key.vehicleId == vehicleId; });
+}
+
+void ResultCache::invalidatePreset(const std::string& presetName) {
+    eraseIf([&](const Key& key) { return key.presetName == presetName; });
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    index.clear();
+    lru.clear();
+}
+
+size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return lru.size();
+}
+
+void ResultCache::displayStats() const {
+    uint64_t h = hits();
+    uint64_t m = misses();
+    double rate = (h + m) > 0 ? 100.0 * static_cast<double>(h) / static_cast<double>(h + m) : 0.0;
+
+    std::cout << "\n--- Result Cache ---\n";
+    std::cout << "Entries:  " << size() << " / " << capacity() << "\n";
+    std::cout << "Hits:     " << h << "\n";
+    std::cout << "Misses:   " << m << "\n";
+    std::cout << "Hit Rate: " << std::fixed << std::setprecision(1) << rate << "%\n";
+}
@@ -0,0 +1,112 @@
+#include "Route.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+
+bool Route::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open route file: " << filename << "\n";
+        return false;
+    }
+
+    segments.clear();
+
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        // Skip a header row such as "length_km,gradient,..."
+        if (segments.empty() && std::isalpha(static_cast<unsigned char>(line[start]))) continue;
+
+        double values[5];
+        const char* p = line.c_str() + start;
+        bool ok = true;
+        for (int i = 0; i < 5; ++i) {
+            char* end = nullptr;
+            values[i] = std::strtod(p, &end);
+            if (end == p || !std::isfinite(values[i])) {
+                ok = false;
+                break;
+            }
+            p = end;
+            while (*p == ' ' || *p == '\t') ++p;
+            if (i < 4) {
+                if (*p != ',') {
+                    ok = false;
+                    break;
+                }
+                ++p;
+            }
+        }
+        // Nothing but the line ending after the last value
+        while (ok && (*p == '\r' || *p == ' ' || *p == '\t')) ++p;
+        if (*p != '\0') ok = false;
+
+        if (!ok || values[0] < 0.0 || values[4] <= 0.0) {
+            std::cerr << "Invalid route segment at line " << lineNo << ": " << line << "\n";
+            segments.clear();
+            return false;
+        }
+
+        segments.push_back({ values[0], values[1], values[2], values[3], values[4] });
+    }
+
+    if (segments.empty()) {
+        std::cerr << "Route file contains no segments: " << filename << "\n";
+        return false;
+    }
+
+    std::cout << "Route loaded: " << segments.size() << " segments, "
+        << totalDistanceKm() << " km.\n";
+    return true;
+}
+
+void Route::addSegment(double lengthKm, double gradient, double roughness, double temperatureC, double speedKmh) {
+    segments.push_back({ lengthKm, gradient, roughness, temperatureC, speedKmh });
+}
+
+double Route::totalDistanceKm() const {
+    double total = 0.0;
+    for (const RouteSegment& seg : segments) total += seg.lengthKm;
+    return total;
+}
+
+double Route::totalDurationHours() const {
+    double total = 0.0;
+    for (const RouteSegment& seg : segments) total += seg.lengthKm / seg.speedKmh;
+    return total;
+}
+
+double Route::averageGradient() const {
+    double sum = 0.0, dist = 0.0;
+    for (const RouteSegment& seg : segments) {
+        sum += seg.gradient * seg.lengthKm;
+        dist += seg.lengthKm;
+    }
+    return dist > 0.0 ? sum / dist : 0.0;
+}
+
+double Route::averageRoughness() const {
+    double sum = 0.0, dist = 0.0;
+    for (const RouteSegment& seg : segments) {
+        sum += seg.roughness * seg.lengthKm;
+        dist += seg.lengthKm;
+    }
+    return dist > 0.0 ? sum / dist : 0.0;
+}
+
+double Route::averageTemperatureC() const {
+    double sum = 0.0, dist = 0.0;
+    for (const RouteSegment& seg : segments) {
+        sum += seg.temperatureC * seg.lengthKm;
+        dist += seg.lengthKm;
+    }
+    return dist > 0.0 ? sum / dist : 0.0;
+}
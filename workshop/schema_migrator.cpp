@@ -0,0 +1,349 @@
+#include "Schema_Migrator.h"
+#include <iostream>
+
+namespace {
+
+    enum class StepKind { TABLE, COLUMN, INDEX };
+
+    // TABLE: definition is the column list of CREATE TABLE IF NOT EXISTS.
+    // COLUMN: adds column `name` with `definition` unless it exists.
+    // INDEX: creates index `name` on the comma-separated columns in
+    // `definition` unless an index of that name or those columns exists.
+    struct Step {
+        StepKind kind;
+        const char* table;
+        const char* name;
+        const char* definition;
+    };
+
+    struct Migration {
+        int version;
+        const char* description;
+        std::vector<Step> steps;
+    };
+
+    // Append new migrations at the end with the next version number; never
+    // edit one that has shipped. Column widths match the fetch buffers in
+    // MySqlStorage.
+    const std::vector<Migration>& migrations() {
+        static const std::vector<Migration> list = {
+            { 1, "Base tables", {
+                { StepKind::TABLE, "users", nullptr,
+                    "username VARCHAR(50) NOT NULL, "
+                    "password_hash VARCHAR(255) NOT NULL, "
+                    "role VARCHAR(10) NOT NULL DEFAULT 'user', "
+                    "created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP, "
+                    "PRIMARY KEY (username)" },
+                { StepKind::TABLE, "vehicles", nullptr,
+                    "vehicle_id VARCHAR(50) NOT NULL, "
+                    "model_name VARCHAR(100) NOT NULL, "
+                    "base_efficiency DOUBLE NOT NULL, "
+                    "mass_kg DOUBLE NOT NULL, "
+                    "drag_coef DOUBLE NOT NULL, "
+                    "frontal_area DOUBLE NOT NULL, "
+                    "engine_rated_power DOUBLE NOT NULL, "
+                    "tire_pressure_bar DOUBLE NOT NULL, "
+                    "has_ac TINYINT(1) NOT NULL DEFAULT 0, "
+                    "PRIMARY KEY (vehicle_id)" },
+                { StepKind::TABLE, "presets", nullptr,
+                    "name VARCHAR(100) NOT NULL, "
+                    "road_gradient DOUBLE NOT NULL, "
+                    "surface_roughness DOUBLE NOT NULL, "
+                    "ambient_temp DOUBLE NOT NULL, "
+                    "PRIMARY KEY (name)" },
+                { StepKind::TABLE, "environment_presets", nullptr,
+                    "id INT NOT NULL AUTO_INCREMENT, "
+                    "terrain_type VARCHAR(50) NOT NULL, "
+                    "climate_type VARCHAR(50) NOT NULL, "
+                    "gradient DOUBLE NOT NULL, "
+                    "roughness DOUBLE NOT NULL, "
+                    "temperature DOUBLE NOT NULL, "
+                    "pressure DOUBLE NOT NULL, "
+                    "PRIMARY KEY (id)" },
+                { StepKind::TABLE, "fuel_prices", nullptr,
+                    "id INT NOT NULL AUTO_INCREMENT, "
+                    "price DECIMAL(10,2) NOT NULL, "
+                    "update_time TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP, "
+                    "PRIMARY KEY (id)" },
+                { StepKind::TABLE, "calculation_history", nullptr,
+                    "id INT NOT NULL AUTO_INCREMENT, "
+                    "username VARCHAR(50) NOT NULL, "
+                    "vehicle_id VARCHAR(50) NOT NULL, "
+                    "mission_name VARCHAR(100) NOT NULL, "
+                    "vehicle_mass DOUBLE, "
+                    "vehicle_drag_coef DOUBLE, "
+                    "vehicle_frontal_area DOUBLE, "
+                    "vehicle_tire_pressure DOUBLE, "
+                    "vehicle_engine_power DOUBLE, "
+                    "vehicle_has_ac TINYINT(1) NOT NULL DEFAULT 0, "
+                    "vehicle_efficiency DOUBLE, "
+                    "road_gradient DOUBLE, "
+                    "surface_roughness DOUBLE, "
+                    "ambient_temp DOUBLE, "
+                    "pressure DOUBLE, "
+                    "distance_km DOUBLE, "
+                    "avg_speed_kmh DOUBLE, "
+                    "fuel_consumed_liters DOUBLE, "
+                    "cost_per_km DOUBLE, "
+                    "calculated_at DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP, "
+                    "PRIMARY KEY (id)" },
+            } },
+            // Hand-made fuel_prices tables often lack the timestamp the
+            // latest-price query orders by
+            { 2, "fuel_prices.update_time", {
+                { StepKind::COLUMN, "fuel_prices", "update_time",
+                    "TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP" },
+            } },
+            // One index per query shape. InnoDB appends the primary key to
+            // every secondary index, so (username, calculated_at) also orders
+            // ties by id for keyset paging, and (username) alone serves the
+            // id-ordered export of one user.
+            { 3, "Indexes for the lookup and history queries", {
+                { StepKind::INDEX, "users", "idx_users_username", "username" },
+                { StepKind::INDEX, "vehicles", "idx_vehicles_vehicle_id", "vehicle_id" },
+                { StepKind::INDEX, "presets", "idx_presets_name", "name" },
+                { StepKind::INDEX, "environment_presets", "idx_environment_terrain", "terrain_type" },
+                { StepKind::INDEX, "environment_presets", "idx_environment_climate", "climate_type" },
+                { StepKind::INDEX, "fuel_prices", "idx_fuel_prices_update_time", "update_time" },
+                { StepKind::INDEX, "calculation_history", "idx_history_user_time", "username,calculated_at" },
+                { StepKind::INDEX, "calculation_history", "idx_history_vehicle_time", "vehicle_id,calculated_at" },
+                { StepKind::INDEX, "calculation_history", "idx_history_time", "calculated_at" },
+                { StepKind::INDEX, "calculation_history", "idx_history_user", "username" },
+            } },
+        };
+        return list;
+    }
+
+    // The selective queries MySqlStorage issues, with sample values in place
+    // of parameters. Keep in step with mysql_storage.cpp when queries change.
+    struct CheckedQuery {
+        const char* label;
+        const char* sql;
+    };
+
+    const CheckedQuery CHECKED_QUERIES[] = {
+        { "vehicle by id", "SELECT model_name FROM vehicles WHERE vehicle_id = 'V'" },
+        { "preset by name", "SELECT road_gradient FROM presets WHERE name = 'P'" },
+        { "environment preset", "SELECT gradient FROM environment_presets "
+            "WHERE terrain_type = 'T' OR climate_type = 'C' LIMIT 1" },
+        { "latest fuel price", "SELECT price FROM fuel_prices ORDER BY update_time DESC LIMIT 1" },
+        { "user by name", "SELECT password_hash, role FROM users WHERE username = 'U' LIMIT 1" },
+        { "history by id", "SELECT mission_name FROM calculation_history WHERE id = 1" },
+        { "history page, one user", "SELECT mission_name FROM calculation_history WHERE username = 'U' "
+            "ORDER BY calculated_at DESC, id DESC LIMIT 21" },
+        { "history page after cursor", "SELECT mission_name FROM calculation_history WHERE username = 'U' "
+            "AND (calculated_at < '2000-01-01 00:00:00' OR (calculated_at = '2000-01-01 00:00:00' AND id < 1)) "
+            "ORDER BY calculated_at DESC, id DESC LIMIT 21" },
+        { "recent history", "SELECT mission_name FROM calculation_history "
+            "ORDER BY calculated_at DESC, id DESC LIMIT 10" },
+        { "history by vehicle", "SELECT mission_name FROM calculation_history WHERE vehicle_id = 'V' "
+            "ORDER BY calculated_at DESC, id DESC LIMIT 10" },
+        { "history date search", "SELECT mission_name FROM calculation_history "
+            "WHERE calculated_at >= '2000-01-01' AND calculated_at <= '2000-01-31 23:59:59' "
+            "ORDER BY calculated_at DESC, id DESC LIMIT 100" },
+        { "history totals, one user", "SELECT COUNT(*), SUM(fuel_consumed_liters) "
+            "FROM calculation_history WHERE username = 'U'" },
+        { "history export, one user", "SELECT mission_name FROM calculation_history "
+            "WHERE username = 'U' ORDER BY id" },
+        { "history users", "SELECT DISTINCT username FROM calculation_history ORDER BY username" },
+    };
+
+    std::string text(const char* value) {
+        return value ? std::string(value) : std::string();
+    }
+
+}
+
+SchemaMigrator::SchemaMigrator(DatabaseManager* db) : db(db) {}
+
+int SchemaMigrator::latestVersion() {
+    return migrations().back().version;
+}
+
+bool SchemaMigrator::execute(const std::string& sql) {
+    if (!db->query(sql, "schema migration DDL")) {
+        std::cerr << "Schema statement failed: " << mysql_error(db->getConnection()) << "\n  " << sql << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SchemaMigrator::queryInt(const std::string& sql, long long& value) {
+    MYSQL_RES* result = db->queryResult(sql, "schema migration lookup");
+    if (!result) {
+        std::cerr << "Schema query failed: " << mysql_error(db->getConnection()) << std::endl;
+        return false;
+    }
+
+    MYSQL_ROW row = mysql_fetch_row(result);
+    value = (row && row[0]) ? std::stoll(row[0]) : 0;
+    mysql_free_result(result);
+    return true;
+}
+
+bool SchemaMigrator::columnExists(const char* table, const char* column) {
+    long long count = 0;
+    return queryInt(std::string("SELECT COUNT(*) FROM information_schema.columns "
+        "WHERE table_schema = DATABASE() AND table_name = '") + table +
+        "' AND column_name = '" + column + "'", count) && count > 0;
+}
+
+bool SchemaMigrator::indexExists(const char* table, const char* name, const char* columns) {
+    long long count = 0;
+    return queryInt(std::string("SELECT COUNT(*) FROM (SELECT index_name, "
+        "GROUP_CONCAT(column_name ORDER BY seq_in_index SEPARATOR ',') AS columns_list "
+        "FROM information_schema.statistics WHERE table_schema = DATABASE() AND table_name = '") + table +
+        "' GROUP BY index_name) i WHERE i.index_name = '" + name + "' OR i.columns_list = '" + columns + "'",
+        count) && count > 0;
+}
+
+int SchemaMigrator::currentVersion() {
+    if (!db || !db->getConnection()) {
+        return -1;
+    }
+
+    long long version = 0;
+    if (!queryInt("SELECT COALESCE(MAX(version), 0) FROM schema_version", version)) {
+        return -1;
+    }
+    return (int)version;
+}
+
+bool SchemaMigrator::migrate() {
+    if (!db || !db->getConnection()) {
+        std::cerr << "Database connection not available.\n";
+        return false;
+    }
+
+    if (!execute("CREATE TABLE IF NOT EXISTS schema_version ("
+        "version INT NOT NULL, "
+        "description VARCHAR(200) NOT NULL, "
+        "applied_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP, "
+        "PRIMARY KEY (version)) ENGINE=InnoDB")) {
+        return false;
+    }
+
+    // Serializes migrations between application instances starting together
+    long long locked = 0;
+    if (!queryInt("SELECT GET_LOCK('fuel_efficiency_schema', 30)", locked) || locked != 1) {
+        std::cerr << "Timed out waiting for another instance to migrate the schema.\n";
+        return false;
+    }
+
+    int version = currentVersion();
+    bool ok = version >= 0;
+
+    for (const Migration& migration : migrations()) {
+        if (!ok) break;
+        if (migration.version <= version) continue;
+
+        for (const Step& step : migration.steps) {
+            switch (step.kind) {
+            case StepKind::TABLE:
+                ok = execute(std::string("CREATE TABLE IF NOT EXISTS ") + step.table +
+                    " (" + step.definition + ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4");
+                break;
+            case StepKind::COLUMN:
+                ok = columnExists(step.table, step.name) ||
+                    execute(std::string("ALTER TABLE ") + step.table + " ADD COLUMN " +
+                        step.name + " " + step.definition);
+                break;
+            case StepKind::INDEX:
+                ok = indexExists(step.table, step.name, step.definition) ||
+                    execute(std::string("CREATE INDEX ") + step.name + " ON " +
+                        step.table + " (" + step.definition + ")");
+                break;
+            }
+            if (!ok) break;
+        }
+
+        // DDL commits implicitly in MySQL, so a failed migration may be half
+        // applied; every step is idempotent and the migration reruns in full
+        // next time
+        if (ok) {
+            ok = execute("INSERT INTO schema_version (version, description) VALUES (" +
+                std::to_string(migration.version) + ", '" + migration.description + "')");
+        }
+        if (ok) {
+            std::cout << "Applied schema migration " << migration.version << ": " << migration.description << "\n";
+        }
+        else {
+            std::cerr << "Schema migration " << migration.version << " (" << migration.description << ") failed.\n";
+        }
+    }
+
+    long long released = 0;
+    queryInt("SELECT RELEASE_LOCK('fuel_efficiency_schema')", released);
+    return ok;
+}
+
+std::vector<SchemaMigrator::QueryPlan> SchemaMigrator::explainQueries() {
+    std::vector<QueryPlan> plans;
+    MYSQL* conn = db ? db->getConnection() : nullptr;
+    if (!conn) {
+        return plans;
+    }
+
+    for (const CheckedQuery& check : CHECKED_QUERIES) {
+        MYSQL_RES* result = db->queryResult(std::string("EXPLAIN ") + check.sql, "EXPLAIN (index check)");
+        if (!result) {
+            std::cerr << "EXPLAIN failed for " << check.label << ": " << mysql_error(conn) << std::endl;
+            continue;
+        }
+
+        // EXPLAIN's column set differs between server versions; find the
+        // ones needed by name
+        int tableColumn = -1, typeColumn = -1, keyColumn = -1, possibleColumn = -1;
+        unsigned int fields = mysql_num_fields(result);
+        for (unsigned int i = 0; i < fields; ++i) {
+            std::string name = mysql_fetch_field_direct(result, i)->name;
+            if (name == "table") tableColumn = (int)i;
+            else if (name == "type") typeColumn = (int)i;
+            else if (name == "key") keyColumn = (int)i;
+            else if (name == "possible_keys") possibleColumn = (int)i;
+        }
+
+        MYSQL_ROW row;
+        while ((row = mysql_fetch_row(result))) {
+            QueryPlan plan;
+            plan.label = check.label;
+            if (tableColumn >= 0) plan.table = text(row[tableColumn]);
+            if (typeColumn >= 0) plan.accessType = text(row[typeColumn]);
+            if (keyColumn >= 0) plan.key = text(row[keyColumn]);
+            if (possibleColumn >= 0) plan.possibleKeys = text(row[possibleColumn]);
+            plans.push_back(plan);
+        }
+        mysql_free_result(result);
+    }
+    return plans;
+}
+
+bool SchemaMigrator::verifyIndexes(bool verbose) {
+    std::vector<QueryPlan> plans = explainQueries();
+    if (plans.empty()) {
+        std::cerr << "Index check skipped: no query plans available.\n";
+        return false;
+    }
+
+    int scans = 0;
+    for (const QueryPlan& plan : plans) {
+        bool fullScan = plan.accessType == "ALL";
+        if (fullScan) ++scans;
+        if (!fullScan && !verbose) continue;
+
+        std::cout << (fullScan ? "Full scan: " : "  ") << plan.label << " -> " << plan.table
+            << " type=" << (plan.accessType.empty() ? "-" : plan.accessType)
+            << " key=" << (plan.key.empty() ? "-" : plan.key) << "\n";
+        if (fullScan) {
+            // With candidate indexes the optimizer chose to scan, which it
+            // does for tables of a few pages; without any the schema is missing one
+            std::cout << "  " << (plan.possibleKeys.empty() ? "no usable index"
+                : "server preferred a scan over " + plan.possibleKeys) << "\n";
+        }
+    }
+
+    if (scans == 0) {
+        std::cout << "Index check: " << plans.size() << " query plans, no full scans.\n";
+    }
+    return scans == 0;
+}
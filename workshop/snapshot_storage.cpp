@@ -0,0 +1,304 @@
+#include "Snapshot_Storage.h"
+#include "Environment.h"
+#include <ctime>
+#include <iostream>
+
+SnapshotStorage::SnapshotStorage(const std::string& path, Storage* backing)
+    : path(path), backing(backing), stale(false), failed(false) {}
+
+SnapshotStorage::~SnapshotStorage() {
+    // The next process should not map what a failed rebuild left behind
+    if (stale.load() || failed.load()) regenerate();
+}
+
+bool SnapshotStorage::open(bool refresh) {
+    if (!refresh) {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        if (snapshot.open(path)) {
+            generation = snapshot.generation();
+            return true;
+        }
+    }
+    if (!backing) {
+        std::cerr << "No usable reference snapshot at " << path << "\n";
+        return false;
+    }
+    return regenerate();
+}
+
+bool SnapshotStorage::regenerate() {
+    if (!needsBacking("Regenerating the reference snapshot")) return false;
+    std::lock_guard<std::mutex> serial(regenerateLock);
+
+    // The slow part - reading the tables - happens while readers still use
+    // the old mapping. Cleared first so an import landing meanwhile marks
+    // the result stale again
+    stale = false;
+    ReferenceData data;
+    bool collected = ReferenceSnapshot::collect(backing, data);
+
+    // Unmapped before the file is replaced; Windows refuses to rename over a
+    // mapped file. A failed rebuild leaves it unmapped, so reads go to the
+    // backing store - which has the change - rather than the old file, and
+    // are not retried one by one; the next write, regenerate() or the
+    // destructor tries again
+    std::unique_lock<std::shared_mutex> guard(lock);
+    snapshot.close();
+    bool written = collected && ReferenceSnapshot::write(path, data, generation + 1);
+    if (!written || !snapshot.open(path)) {
+        failed = true;
+        std::cerr << "Reference data is read from " << backing->backendName() << " until the snapshot is rebuilt.\n";
+        return false;
+    }
+    failed = false;
+    generation = snapshot.generation();
+    return true;
+}
+
+bool SnapshotStorage::needsBacking(const char* what) const {
+    if (backing) return true;
+    std::cerr << what << " needs a database; this process has only the reference snapshot.\n";
+    return false;
+}
+
+int SnapshotStorage::changed(int rows) {
+    if (rows > 0) regenerate();
+    return rows;
+}
+
+void SnapshotStorage::refreshIfStale() {
+    if (stale.load()) regenerate();
+}
+
+// VEHICLES
+
+bool SnapshotStorage::vehicleExists(const std::string& id) {
+    Vehicle found(nullptr);
+    return loadVehicle(id, found);
+}
+
+bool SnapshotStorage::loadVehicle(const std::string& id, Vehicle& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) return snapshot.findVehicle(id, out);
+    }
+    return backing && backing->loadVehicle(id, out);
+}
+
+bool SnapshotStorage::loadAllVehicles(std::vector<Vehicle>& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) {
+            out = snapshot.vehicles(this);
+            return true;
+        }
+    }
+    out.clear();
+    return backing && backing->loadAllVehicles(out);
+}
+
+int SnapshotStorage::insertVehicle(const Vehicle& vehicle) {
+    if (!needsBacking("Adding a vehicle")) return -1;
+    return changed(backing->insertVehicle(vehicle));
+}
+
+int SnapshotStorage::updateVehicle(const Vehicle& changes) {
+    if (!needsBacking("Updating a vehicle")) return -1;
+    return changed(backing->updateVehicle(changes));
+}
+
+int SnapshotStorage::deleteVehicle(const std::string& id) {
+    if (!needsBacking("Deleting a vehicle")) return -1;
+    return changed(backing->deleteVehicle(id));
+}
+
+int SnapshotStorage::upsertVehicles(const std::vector<Vehicle>& vehicles) {
+    if (!needsBacking("Importing vehicles")) return -1;
+
+    // An import arrives in many batches; rebuild once it is read
+    int written = backing->upsertVehicles(vehicles);
+    if (written > 0) stale = true;
+    return written;
+}
+
+// MISSION PRESETS
+
+bool SnapshotStorage::savePreset(const MissionPreset& preset) {
+    if (!needsBacking("Saving a preset")) return false;
+    return changed(backing->savePreset(preset) ? 1 : 0) > 0;
+}
+
+int SnapshotStorage::loadPreset(const std::string& name, MissionPreset& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) return snapshot.findPreset(name, out) ? 1 : 0;
+    }
+    return backing ? backing->loadPreset(name, out) : -1;
+}
+
+bool SnapshotStorage::listPresets(std::vector<MissionPreset>& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) {
+            out = snapshot.presets();
+            return true;
+        }
+    }
+    out.clear();
+    return backing && backing->listPresets(out);
+}
+
+int SnapshotStorage::deletePreset(const std::string& name) {
+    if (!needsBacking("Deleting a preset")) return -1;
+    return changed(backing->deletePreset(name));
+}
+
+// ENVIRONMENT PRESETS
+
+bool SnapshotStorage::findEnvironment(const std::string& terrain, const std::string& climate, Environment& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) return snapshot.findEnvironment(terrain, climate, out);
+    }
+    return backing && backing->findEnvironment(terrain, climate, out);
+}
+
+bool SnapshotStorage::listEnvironments(std::vector<EnvironmentPreset>& out) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) {
+            out = snapshot.environments();
+            return true;
+        }
+    }
+    out.clear();
+    return backing && backing->listEnvironments(out);
+}
+
+// FUEL PRICE
+
+bool SnapshotStorage::loadFuelPrice(double& price) {
+    refreshIfStale();
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        if (snapshot.isOpen()) return snapshot.fuelPrice(price);
+    }
+    return backing && backing->loadFuelPrice(price);
+}
+
+bool SnapshotStorage::saveFuelPrice(double price) {
+    if (!needsBacking("Saving the fuel price")) return false;
+    return changed(backing->saveFuelPrice(price) ? 1 : 0) > 0;
+}
+
+// USERS
+
+bool SnapshotStorage::findUser(const std::string& username, UserAccount& out) {
+    return needsBacking("Looking up a user") && backing->findUser(username, out);
+}
+
+std::vector<UserAccount> SnapshotStorage::listUsers() {
+    if (!needsBacking("Listing users")) return std::vector<UserAccount>();
+    return backing->listUsers();
+}
+
+int SnapshotStorage::countUsers() {
+    if (!needsBacking("Counting users")) return -1;
+    return backing->countUsers();
+}
+
+int SnapshotStorage::insertUser(const UserAccount& user) {
+    if (!needsBacking("Registering a user")) return -1;
+    return backing->insertUser(user);
+}
+
+int SnapshotStorage::updatePasswordHash(const std::string& username, const std::string& passwordHash) {
+    if (!needsBacking("Changing a password")) return -1;
+    return backing->updatePasswordHash(username, passwordHash);
+}
+
+int SnapshotStorage::updateRole(const std::string& username, const std::string& role) {
+    if (!needsBacking("Changing a role")) return -1;
+    return backing->updateRole(username, role);
+}
+
+int SnapshotStorage::deleteUser(const std::string& username) {
+    if (!needsBacking("Deleting a user")) return -1;
+    return backing->deleteUser(username);
+}
+
+// CALCULATION HISTORY
+
+bool SnapshotStorage::appendCalculations(const std::vector<CalculationRecord>& records) {
+    return needsBacking("Saving calculation history") && backing->appendCalculations(records);
+}
+
+std::vector<CalculationRecord> SnapshotStorage::queryCalculations(const CalculationQuery& query) {
+    if (!needsBacking("Reading calculation history")) return std::vector<CalculationRecord>();
+    return backing->queryCalculations(query);
+}
+
+bool SnapshotStorage::getCalculation(int id, CalculationRecord& out) {
+    return needsBacking("Reading calculation history") && backing->getCalculation(id, out);
+}
+
+int SnapshotStorage::deleteCalculation(int id, const std::string& owner) {
+    if (!needsBacking("Deleting a calculation")) return -1;
+    return backing->deleteCalculation(id, owner);
+}
+
+int SnapshotStorage::deleteUserCalculations(const std::string& username) {
+    if (!needsBacking("Deleting calculations")) return -1;
+    return backing->deleteUserCalculations(username);
+}
+
+CalculationTotals SnapshotStorage::calculationTotals(const std::string& username) {
+    if (!needsBacking("Reading calculation history")) return CalculationTotals();
+    return backing->calculationTotals(username);
+}
+
+std::vector<std::string> SnapshotStorage::calculationUsers() {
+    if (!needsBacking("Reading calculation history")) return std::vector<std::string>();
+    return backing->calculationUsers();
+}
+
+bool SnapshotStorage::scanCalculations(const std::string& username,
+    const std::function<void(const CalculationRecord&)>& visit) {
+    return needsBacking("Reading calculation history") && backing->scanCalculations(username, visit);
+}
+
+size_t SnapshotStorage::maxConcurrency() const {
+    return backing ? backing->maxConcurrency() : 1;
+}
+
+void SnapshotStorage::displayStats() const {
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        std::cout << "\n--- Reference Snapshot ---\n";
+        std::cout << "File: " << path << "\n";
+        if (snapshot.isOpen()) {
+            std::time_t created = (std::time_t)snapshot.createdAt();
+            char when[20] = "";
+            std::tm local = {};
+#ifdef _WIN32
+            localtime_s(&local, &created);
+#else
+            localtime_r(&created, &local);
+#endif
+            std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &local);
+            std::cout << "Generation: " << snapshot.generation() << " | Written: " << when
+                << " | Size: " << snapshot.fileSize() << " bytes\n";
+            std::cout << "Vehicles: " << snapshot.vehicleCount() << " | Presets: " << snapshot.presetCount() << "\n";
+        }
+        else {
+            std::cout << "Not mapped; reference data comes from the backing store.\n";
+        }
+    }
+    if (backing) backing->displayStats();
+}
@@ -0,0 +1,112 @@
+#include "Speed_Optimizer.h"
+#include "Thread_Pool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+SpeedOptimizer::SpeedOptimizer(double minSpeedKmh, double maxSpeedKmh)
+    : minSpeed(minSpeedKmh), maxSpeed(maxSpeedKmh) {
+}
+
+double SpeedOptimizer::litersPerKm(const Vehicle& veh, const Environment& env, double speedKmh) const {
+    return calculator.calculate(veh, env, 1.0, speedKmh);
+}
+
+CruiseSpeedResult SpeedOptimizer::solve(const Vehicle& veh, const Environment& env,
+    double curveHalfWidthKmh, int curvePoints) const {
+
+    CruiseSpeedResult result;
+    result.vehicle_id = veh.vehicle_id;
+
+    // 1. Coarse bracket
+    const int bracketPoints = 12;
+    double step = (maxSpeed - minSpeed) / (bracketPoints - 1);
+    int best = 0;
+    double bestValue = litersPerKm(veh, env, minSpeed);
+    for (int i = 1; i < bracketPoints; ++i) {
+        double value = litersPerKm(veh, env, minSpeed + step * i);
+        if (value < bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    result.evaluations = bracketPoints;
+
+    double a = minSpeed + step * (std::max)(0, best - 1);
+    double b = minSpeed + step * (std::min)(bracketPoints - 1, best + 1);
+
+    // 2. Golden-section search inside [a, b]
+    const double invPhi = (std::sqrt(5.0) - 1.0) / 2.0;
+    double c = b - invPhi * (b - a);
+    double d = a + invPhi * (b - a);
+    double fc = litersPerKm(veh, env, c);
+    double fd = litersPerKm(veh, env, d);
+    result.evaluations += 2;
+
+    while (b - a > TOLERANCE_KMH) {
+        if (fc < fd) {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - invPhi * (b - a);
+            fc = litersPerKm(veh, env, c);
+        }
+        else {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + invPhi * (b - a);
+            fd = litersPerKm(veh, env, d);
+        }
+        ++result.evaluations;
+    }
+
+    result.speedKmh = (a + b) / 2.0;
+    result.litersPerKm = litersPerKm(veh, env, result.speedKmh);
+    ++result.evaluations;
+
+    // 3. Fuel curve around the optimum
+    if (curvePoints > 1) {
+        double lo = (std::max)(minSpeed, result.speedKmh - curveHalfWidthKmh);
+        double hi = (std::min)(maxSpeed, result.speedKmh + curveHalfWidthKmh);
+        result.curve.reserve(curvePoints);
+        for (int i = 0; i < curvePoints; ++i) {
+            double speed = lo + (hi - lo) * i / (curvePoints - 1);
+            result.curve.push_back({ speed, litersPerKm(veh, env, speed) });
+        }
+    }
+
+    return result;
+}
+
+std::vector<CruiseSpeedResult> SpeedOptimizer::solveFleet(const std::vector<Vehicle>& vehicles,
+    const Environment& env, ThreadPool& pool) const {
+
+    std::vector<CruiseSpeedResult> results(vehicles.size());
+    pool.parallelFor(vehicles.size(), 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = solve(vehicles[i], env);
+        }
+    });
+    return results;
+}
+
+void SpeedOptimizer::displayResult(const CruiseSpeedResult& result) const {
+    std::cout << "\n--- Optimal Cruise Speed: " << result.vehicle_id << " ---\n";
+    std::cout << "Optimal Speed: " << std::fixed << std::setprecision(1) << result.speedKmh << " km/h\n";
+    std::cout << "Fuel Rate: " << std::setprecision(4) << result.litersPerKm << " L/km ("
+        << std::setprecision(2) << result.litersPerKm * 100.0 << " L/100km)\n";
+
+    if (!result.curve.empty()) {
+        std::cout << "\n" << std::left << std::setw(14) << "Speed (km/h)"
+            << std::setw(12) << "L/100km"
+            << "vs optimum\n";
+        std::cout << std::string(36, '-') << "\n";
+        for (const FuelCurvePoint& p : result.curve) {
+            std::cout << std::left << std::setw(14) << std::setprecision(1) << p.speedKmh
+                << std::setw(12) << std::setprecision(2) << p.litersPerKm * 100.0
+                << "+" << std::setprecision(1) << (p.litersPerKm / result.litersPerKm - 1.0) * 100.0 << "%\n";
+        }
+    }
+}
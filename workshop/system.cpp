@@ -3,16 +3,40 @@
 #include "Auth.h"
 #include "Preset.h"
 #include "Cost.h"
+#include "Parameter_Sweep.h"
+#include "Speed_Optimizer.h"
+#include "Monte_Carlo.h"
+#include "Drive_Cycle.h"
+#include "Vehicle_Importer.h"
 #include <iostream>
 #include <string>
 #include <limits>
 #include <iomanip>
-#include <mysql.h>
+#include <chrono>
+#include <algorithm>
 
-System::System(DatabaseManager* db)
-    : db(db), preset(db), vehicle(db), environment(), calculator(),
-    calcHistory(db),
+namespace {
+
+    HistoryWriter::Options historyOptions(HistoryWriter::Mode mode) {
+        HistoryWriter::Options options;
+        options.mode = mode;
+        return options;
+    }
+
+}
+
+System::System(Storage* storage, HistoryWriter::Mode historyMode)
+    : storage(storage), preset(storage), vehicle(storage), environment(), calculator(),
+    calcHistory(storage), historyWriter(storage, historyOptions(historyMode)), workers(), resultCache(), vehicleCatalog(storage),
     currentUser(""), currentRole(Auth::Role::USER) {
+    // Vehicle and preset edits drop the cached results built on them
+    vehicle.setResultCache(&resultCache);
+    preset.setResultCache(&resultCache);
+
+    // Vehicles are read once; lookups and edits then go through the catalog
+    if (vehicleCatalog.load()) {
+        vehicle.setCatalog(&vehicleCatalog);
+    }
 }
 
 void System::runApplication() {
@@ -23,7 +47,7 @@ void System::runApplication() {
     std::cout << "========================================\n";
 
     // Login
-    Auth auth(db);
+    Auth auth(storage);
 
     std::cout << "\n--- Authentication Required ---\n";
     if (!auth.login(currentUser, currentRole)) {
@@ -74,6 +98,15 @@ void System::runApplication() {
                 std::cout << "Invalid selection: Please try again.\n";
             }
             break;
+        case 7:  // Storage backend
+            if (currentRole == Auth::Role::ADMIN) {
+                storage->displayStats();
+                historyWriter.displayStats();
+            }
+            else {
+                std::cout << "Invalid selection. Please try again.\n";
+            }
+            break;
         case 99: // Exit
             std::cout << "Exiting system... Goodbye!\n";
             running = false;
@@ -98,6 +131,7 @@ void System::displayMainMenu() {
     if (currentRole == Auth::Role::ADMIN) {
         std::cout << "5. User Management\n";
         std::cout << "6. Fuel Price Management\n";
+        std::cout << "7. Storage Statistics\n";
     }
     std::cout << "99. Exit\n";
     std::cout << "========================================\n";
@@ -107,10 +141,15 @@ void System::displayMainMenu() {
 void System::missionSetup() {
     std::cout << "\n=== MISSION SETUP ===\n";
     std::cout << "1. Manual Mission Configuration\n";
-    std::cout << "2. Load Mission Preset\n";
-    std::cout << "3. Save Current Mission as Preset\n";
-    std::cout << "4. Delete Mission Preset\n";
-    std::cout << "5. List All Mission Presets\n";
+    std::cout << "2. Fuel-Optimal Cruise Speed\n";
+    std::cout << "3. Load Mission Preset\n";
+    std::cout << "4. Save Current Mission as Preset\n";
+    std::cout << "5. Delete Mission Preset\n";
+    std::cout << "6. List All Mission Presets\n";
+    std::cout << "7. Parameter Sweep (What-If Grid)\n";
+    std::cout << "8. Monte Carlo Uncertainty Analysis\n";
+    std::cout << "9. Drive Cycle (Speed Trace File)\n";
+    std::cout << "10. Cache Statistics\n";
     std::cout << "0. Back to Main Menu\n";
     std::cout << "Selection: ";
 
@@ -122,17 +161,33 @@ void System::missionSetup() {
         runManualMission();
         break;
     case 2:
-        loadMissionPreset();
+        runOptimalSpeed();
         break;
     case 3:
-        saveMissionPreset();
+        loadMissionPreset();
         break;
     case 4:
-        deleteMissionPreset();
+        saveMissionPreset();
         break;
     case 5:
+        deleteMissionPreset();
+        break;
+    case 6:
         preset.listPresets();
         break;
+    case 7:
+        runParameterSweep();
+        break;
+    case 8:
+        runMonteCarlo();
+        break;
+    case 9:
+        runDriveCycleMission();
+        break;
+    case 10:
+        resultCache.displayStats();
+        preset.displayCacheStats();
+        break;
     default:
         break;
     }
@@ -147,6 +202,14 @@ void System::runManualMission() {
     std::cin.ignore();
     std::getline(std::cin, mission_name);
 
+    char routeChoice;
+    std::cout << "Use a segmented route file instead of a single gradient? (y/n): ";
+    std::cin >> routeChoice;
+    if (routeChoice == 'y' || routeChoice == 'Y') {
+        runRouteMission(mission_name);
+        return;
+    }
+
     // Environment input
     double grad, rough, temp;
     std::cout << "> Road Gradient (e.g., 0.05 for 5%): "; std::cin >> grad;
@@ -166,54 +229,384 @@ void System::runManualMission() {
     std::cout << "\n--- Vehicle Selection ---\n";
     std::cout << "> Vehicle ID: "; std::cin >> vId;
 
+    // Reruns of the same mission skip the vehicle lookup and the calculation
+    ResultCache::Key key = ResultCache::manualKey(vId, grad, rough, temp, distance, speed);
+    ResultCache::Entry cached;
+    double totalFuelLiters;
+
+    if (resultCache.find(key, cached)) {
+        vehicle = cached.vehicle;
+        totalFuelLiters = cached.liters;
+    }
+    else {
+        if (!vehicle.loadVehicle(vId)) {
+            std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
+            return;
+        }
+
+        totalFuelLiters = calculator.calculate(vehicle, environment, distance, speed);
+
+        cached.vehicle = vehicle;
+        cached.roadGradient = grad;
+        cached.surfaceRoughness = rough;
+        cached.ambientTempC = temp;
+        cached.liters = totalFuelLiters;
+        resultCache.store(key, cached);
+    }
+
+    // Display results
+    calculator.displayReport(totalFuelLiters, distance);
+
+    // Save to history
+    saveCalculationToHistory(mission_name, distance, speed, totalFuelLiters);
+}
+
+void System::runRouteMission(const std::string& mission_name) {
+    std::string filename;
+    std::cout << "> Route file (CSV: length_km,gradient,roughness,temperature_c,speed_kmh): ";
+    std::cin >> filename;
+
+    Route route;
+    if (!route.loadFromFile(filename)) {
+        return;
+    }
+
+    // Vehicle selection
+    std::string vId;
+    std::cout << "\n--- Vehicle Selection ---\n";
+    std::cout << "> Vehicle ID: "; std::cin >> vId;
+
     if (!vehicle.loadVehicle(vId)) {
         std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
         return;
     }
 
-    // Calculate and display results
-    double totalFuelLiters = calculator.calculate(vehicle, environment, distance, speed);
+    double distance = route.totalDistanceKm();
+    double hours = route.totalDurationHours();
+    double speed = hours > 0 ? distance / hours : 0.0;
+
+    // History stores one environment per mission, so log the route averages
+    environment.setRawEnvironment(route.averageGradient(), route.averageRoughness(), route.averageTemperatureC());
+
+    double totalFuelLiters = calculator.calculateRoute(vehicle, route, environment.pressurePa);
     calculator.displayReport(totalFuelLiters, distance);
+    std::cout << "Route Segments: " << route.segments.size() << std::endl;
 
-    // Save to history
     saveCalculationToHistory(mission_name, distance, speed, totalFuelLiters);
 }
 
+void System::runDriveCycleMission() {
+    std::cout << "\n--- Drive Cycle Mission ---\n";
+
+    std::string mission_name;
+    std::cout << "Mission Name (optional, for history): ";
+    std::cin.ignore();
+    std::getline(std::cin, mission_name);
+
+    std::string filename;
+    std::cout << "> Speed trace file (one km/h sample per line, or time_s,speed_kmh): ";
+    std::cin >> filename;
+
+    double interval;
+    std::cout << "> Sample Interval (s, 1 for 1 Hz): "; std::cin >> interval;
+    if (!std::cin || interval <= 0.0) {
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        std::cout << "Invalid sample interval.\n";
+        return;
+    }
+
+    double grad, rough, temp;
+    std::cout << "> Road Gradient (e.g., 0.05 for 5%): "; std::cin >> grad;
+    std::cout << "> Surface Roughness (1.0=Asphalt, 1.5=Gravel, 2.5=Mud): "; std::cin >> rough;
+    std::cout << "> Ambient Temperature (Celsius): "; std::cin >> temp;
+
+    environment.setRawEnvironment(grad, rough, temp);
+
+    std::string vId;
+    std::cout << "\n--- Vehicle Selection ---\n";
+    std::cout << "> Vehicle ID: "; std::cin >> vId;
+
+    if (!vehicle.loadVehicle(vId)) {
+        std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
+        return;
+    }
+
+    DriveCycle cycle(vehicle, environment, interval);
+    auto start = std::chrono::steady_clock::now();
+    if (!cycle.addFile(filename)) {
+        return;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    DriveCycleResult result = cycle.result();
+    cycle.displayResult(result);
+    std::cout << "Processed in " << std::fixed << std::setprecision(3) << seconds << " s\n";
+
+    // Same mission at its average speed, for comparison
+    if (result.distanceKm > 0.0) {
+        double steadyLiters = calculator.calculate(vehicle, environment, result.distanceKm, result.averageSpeedKmh());
+        std::cout << "Average-Speed Model: " << std::setprecision(3) << steadyLiters << " L\n";
+    }
+
+    saveCalculationToHistory(mission_name, result.distanceKm, result.averageSpeedKmh(), result.liters);
+}
+
+void System::runOptimalSpeed() {
+    std::cout << "\n--- Fuel-Optimal Cruise Speed ---\n";
+
+    double grad, rough, temp;
+    std::cout << "> Road Gradient (e.g., 0.05 for 5%): "; std::cin >> grad;
+    std::cout << "> Surface Roughness (1.0=Asphalt, 1.5=Gravel, 2.5=Mud): "; std::cin >> rough;
+    std::cout << "> Ambient Temperature (Celsius): "; std::cin >> temp;
+
+    environment.setRawEnvironment(grad, rough, temp);
+
+    std::string vId;
+    std::cout << "> Vehicle ID (or ALL for the whole fleet): "; std::cin >> vId;
+
+    SpeedOptimizer optimizer;
+
+    if (vId == "ALL" || vId == "all") {
+        // Not in use when the vehicles could not be read at startup
+        if (!vehicle.catalog) {
+            if (!vehicleCatalog.load()) {
+                std::cerr << "Could not load the vehicle list.\n";
+                return;
+            }
+            vehicle.setCatalog(&vehicleCatalog);
+        }
+
+        std::vector<Vehicle> fleet = vehicleCatalog.all();
+        if (fleet.empty()) {
+            std::cout << "No vehicles found.\n";
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<CruiseSpeedResult> results = optimizer.solveFleet(fleet, environment, workers);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "\n" << std::left << std::setw(15) << "Vehicle"
+            << std::setw(15) << "Speed (km/h)"
+            << std::setw(12) << "L/100km"
+            << "\n";
+        std::cout << std::string(42, '-') << "\n";
+        for (const CruiseSpeedResult& r : results) {
+            std::cout << std::left << std::setw(15) << r.vehicle_id
+                << std::setw(15) << std::fixed << std::setprecision(1) << r.speedKmh
+                << std::setw(12) << std::fixed << std::setprecision(2) << r.litersPerKm * 100.0
+                << "\n";
+        }
+        std::cout << "Solved " << results.size() << " vehicles in "
+            << std::setprecision(3) << seconds << " s\n";
+        return;
+    }
+
+    if (!vehicle.loadVehicle(vId)) {
+        std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
+        return;
+    }
+
+    optimizer.displayResult(optimizer.solve(vehicle, environment));
+}
+
+void System::runParameterSweep() {
+    std::cout << "\n--- Parameter Sweep ---\n";
+    std::cout << "Enter each range as: start stop steps (steps = 1 for a fixed value)\n";
+
+    const char* prompts[SWEEP_AXES] = {
+        "> Tire Pressure (bar): ",
+        "> Ambient Temperature (Celsius): ",
+        "> Surface Roughness: ",
+        "> Road Gradient: ",
+        "> Average Speed (km/h): "
+    };
+
+    SweepSpec spec;
+    for (int a = 0; a < SWEEP_AXES; ++a) {
+        std::cout << prompts[a];
+        std::cin >> spec.axes[a].start >> spec.axes[a].stop >> spec.axes[a].steps;
+        if (!std::cin || spec.axes[a].steps == 0) {
+            std::cin.clear();
+            std::cin.ignore(10000, '\n');
+            std::cout << "Invalid range.\n";
+            return;
+        }
+    }
+
+    std::cout << "> Total Distance (km): "; std::cin >> spec.distanceKm;
+
+    char precisionChoice;
+    std::cout << "Use single precision for faster, approximate results? (y/n): ";
+    std::cin >> precisionChoice;
+    if (precisionChoice == 'y' || precisionChoice == 'Y') {
+        spec.precision = Calculator::Precision::FLOAT;
+    }
+
+    std::string vId;
+    std::cout << "> Vehicle ID: "; std::cin >> vId;
+    if (!vehicle.loadVehicle(vId)) {
+        std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
+        return;
+    }
+
+    std::cout << "Evaluating " << spec.pointCount() << " grid points on "
+        << workers.size() << " threads...\n";
+
+    auto start = std::chrono::steady_clock::now();
+    ParameterSweep sweep(workers);
+    SweepResult result = sweep.run(vehicle, spec);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double minFuel = result.liters.empty() ? 0.0 : result.liters[0];
+    double maxFuel = minFuel;
+    size_t minIndex = 0;
+    for (size_t i = 0; i < result.liters.size(); ++i) {
+        if (result.liters[i] < minFuel) {
+            minFuel = result.liters[i];
+            minIndex = i;
+        }
+        if (result.liters[i] > maxFuel) maxFuel = result.liters[i];
+    }
+
+    size_t coords[SWEEP_AXES];
+    result.coordinates(minIndex, coords);
+
+    std::cout << "\n--- Sweep Report ---\n";
+    std::cout << "Completed in " << std::fixed << std::setprecision(3) << seconds << " s\n";
+    std::cout << "Fuel range: " << std::setprecision(2) << minFuel << " - " << maxFuel << " L\n";
+    std::cout << "Best point: tire " << spec.axes[AXIS_TIRE_PRESSURE].at(coords[AXIS_TIRE_PRESSURE])
+        << " bar, temp " << spec.axes[AXIS_TEMPERATURE].at(coords[AXIS_TEMPERATURE])
+        << " C, roughness " << spec.axes[AXIS_ROUGHNESS].at(coords[AXIS_ROUGHNESS])
+        << ", gradient " << spec.axes[AXIS_GRADIENT].at(coords[AXIS_GRADIENT])
+        << ", speed " << spec.axes[AXIS_SPEED].at(coords[AXIS_SPEED]) << " km/h\n";
+
+    std::string filename;
+    std::cout << "\nSave results to file (.csv or .bin, '-' to skip): ";
+    std::cin >> filename;
+    if (filename == "-") return;
+
+    bool binary = filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+    bool saved = binary ? result.writeBinary(filename) : result.writeCSV(filename);
+    if (saved) {
+        std::cout << "Sweep results written to " << filename << "\n";
+    }
+}
+
+// Prompts for one input distribution
+static Distribution readDistribution(const std::string& label) {
+    char kind;
+    std::cout << "> " << label << " [f=fixed, u=uniform, n=normal, t=triangular]: ";
+    std::cin >> kind;
+
+    double a = 0, b = 0, c = 0;
+    switch (kind) {
+    case 'u': case 'U':
+        std::cout << "  min max: "; std::cin >> a >> b;
+        return Distribution::uniform(a, b);
+    case 'n': case 'N':
+        std::cout << "  mean stddev: "; std::cin >> a >> b;
+        return Distribution::normal(a, b);
+    case 't': case 'T':
+        std::cout << "  min mode max: "; std::cin >> a >> b >> c;
+        return Distribution::triangular(a, b, c);
+    default:
+        std::cout << "  value: "; std::cin >> a;
+        return Distribution::fixed(a);
+    }
+}
+
+void System::runMonteCarlo() {
+    std::cout << "\n--- Monte Carlo Uncertainty Analysis ---\n";
+
+    MonteCarloSpec spec;
+    spec.gradient = readDistribution("Road Gradient");
+    spec.roughness = readDistribution("Surface Roughness");
+    spec.temperatureC = readDistribution("Ambient Temperature (Celsius)");
+    spec.speedKmh = readDistribution("Average Speed (km/h)");
+
+    std::cout << "> Total Distance (km): "; std::cin >> spec.distanceKm;
+    std::cout << "> Number of Draws: "; std::cin >> spec.draws;
+    std::cout << "> Random Seed: "; std::cin >> spec.seed;
+
+    if (!std::cin) {
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        std::cout << "Invalid input.\n";
+        return;
+    }
+
+    std::string vId;
+    std::cout << "> Vehicle ID: "; std::cin >> vId;
+    if (!vehicle.loadVehicle(vId)) {
+        std::cout << "Vehicle not found. Please add vehicle first via Vehicle Management.\n";
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MonteCarloEngine engine(workers);
+    MonteCarloResult result = engine.run(vehicle, spec);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    engine.displayResult(result);
+    std::cout << "Completed in " << std::fixed << std::setprecision(3) << seconds << " s\n";
+}
+
 void System::loadMissionPreset() {
     preset.listPresets();
     std::string pName;
     std::cout << "Enter Profile Name to Load: ";
     std::cin >> pName;
 
-    double g, r, t;
-    if (preset.loadPreset(pName, g, r, t)) {
-        environment.setRawEnvironment(g, r, t);
-        std::cout << "Mission profile '" << pName << "' loaded successfully.\n";
-
-        // Continue with mission setup
-        double distance, speed;
-        std::cout << "\n--- Mission Details ---\n";
-        std::cout << "> Total Distance (km): "; std::cin >> distance;
-        std::cout << "> Planned Average Speed (km/h): "; std::cin >> speed;
+    double distance, speed;
+    std::cout << "\n--- Mission Details ---\n";
+    std::cout << "> Total Distance (km): "; std::cin >> distance;
+    std::cout << "> Planned Average Speed (km/h): "; std::cin >> speed;
 
-        std::string vId;
-        std::cout << "> Vehicle ID: "; std::cin >> vId;
+    std::string vId;
+    std::cout << "> Vehicle ID: "; std::cin >> vId;
 
-        if (vehicle.loadVehicle(vId)) {
-            double totalFuelLiters = calculator.calculate(vehicle, environment, distance, speed);
-            calculator.displayReport(totalFuelLiters, distance);
+    // A cached run carries the preset's environment and the vehicle record,
+    // so neither needs to be reloaded
+    ResultCache::Key key = ResultCache::presetKey(vId, pName, distance, speed);
+    ResultCache::Entry cached;
+    double totalFuelLiters;
 
-            // Save to history
-            std::string mission_name = "Preset: " + pName;
-            saveCalculationToHistory(mission_name, distance, speed, totalFuelLiters);
+    if (resultCache.find(key, cached)) {
+        environment.setRawEnvironment(cached.roadGradient, cached.surfaceRoughness, cached.ambientTempC);
+        vehicle = cached.vehicle;
+        totalFuelLiters = cached.liters;
+    }
+    else {
+        double g, r, t;
+        if (!preset.loadPreset(pName, g, r, t)) {
+            std::cout << "Error: Profile not found.\n";
+            return;
         }
-        else {
+        environment.setRawEnvironment(g, r, t);
+
+        if (!vehicle.loadVehicle(vId)) {
             std::cout << "Vehicle not found.\n";
+            return;
         }
+
+        totalFuelLiters = calculator.calculate(vehicle, environment, distance, speed);
+
+        cached.vehicle = vehicle;
+        cached.roadGradient = g;
+        cached.surfaceRoughness = r;
+        cached.ambientTempC = t;
+        cached.liters = totalFuelLiters;
+        resultCache.store(key, cached);
     }
-    else {
-        std::cout << "Error: Profile not found.\n";
-    }
+
+    std::cout << "Mission profile '" << pName << "' loaded successfully.\n";
+    calculator.displayReport(totalFuelLiters, distance);
+
+    // Save to history
+    std::string mission_name = "Preset: " + pName;
+    saveCalculationToHistory(mission_name, distance, speed, totalFuelLiters);
 }
 
 void System::saveMissionPreset() {
@@ -241,6 +634,7 @@ void System::manageVehicles() {
     std::cout << "2. Add New Vehicle\n";
     std::cout << "3. Update Vehicle\n";
     std::cout << "4. Delete Vehicle\n";
+    std::cout << "5. Import Vehicles from CSV\n";
     std::cout << "0. Back to Main Menu\n";
     std::cout << "Selection: ";
 
@@ -260,6 +654,9 @@ void System::manageVehicles() {
     case 4:
         deleteVehicle();
         break;
+    case 5:
+        importVehicles();
+        break;
     default:
         break;
     }
@@ -273,7 +670,7 @@ void System::addNewVehicle() {
     std::cout << "\n--- Add New Vehicle ---\n";
     std::cout << "Vehicle ID: "; std::cin >> id;
 
-    if (vehicle.loadVehicle(id)) {
+    if (vehicle.vehicleExists(id)) {
         std::cout << "Vehicle ID already exists.\n";
         return;
     }
@@ -389,6 +786,27 @@ void System::deleteVehicle() {
     vehicle.deleteVehicle(id);
 }
 
+void System::importVehicles() {
+    std::string path;
+    std::cout << "\n--- Import Vehicles ---\n";
+    std::cout << "Columns: vehicle_id, model_name, base_efficiency, mass_kg, drag_coef, frontal_area,\n"
+        << "         engine_rated_power, tire_pressure_bar (optional), has_ac (optional)\n";
+    std::cout << "CSV file: ";
+    std::cin >> path;
+
+    VehicleImporter importer(storage, &vehicleCatalog);
+    VehicleImporter::Result result;
+    if (!importer.importFile(path, result)) {
+        std::cout << "Import failed.\n";
+        return;
+    }
+
+    // Existing vehicles may have been replaced
+    if (result.imported > 0) resultCache.clear();
+
+    VehicleImporter::displayResult(result);
+}
+
 // USER MANAGEMENT FUNCTIONS
 void System::userManagementMenu() {
     std::cout << "\n=== USER MANAGEMENT ===\n";
@@ -425,7 +843,7 @@ void System::userManagementMenu() {
 }
 
 void System::adminRegisterUser() {
-    Auth auth(db);
+    Auth auth(storage);
 
     std::cout << "\n=== ADMIN: REGISTER NEW USER ===\n";
 
@@ -463,7 +881,7 @@ void System::adminRegisterUser() {
 }
 
 void System::updateUserProfile() {
-    Auth auth(db);
+    Auth auth(storage);
 
     std::string newPassword;
     std::cout << "\n=== UPDATE MY PROFILE ===\n";
@@ -479,7 +897,7 @@ void System::updateUserProfile() {
 }
 
 void System::updateOtherUserProfile() {
-    Auth auth(db);
+    Auth auth(storage);
 
     std::string targetUser, newPassword;
     std::cout << "\n=== UPDATE USER PROFILE ===\n";
@@ -494,7 +912,7 @@ void System::updateOtherUserProfile() {
 }
 
 void System::deleteUserAccount() {
-    Auth auth(db);
+    Auth auth(storage);
 
     std::string targetUser;
     std::cout << "\n=== DELETE USER ACCOUNT ===\n";
@@ -512,12 +930,12 @@ void System::deleteUserAccount() {
 }
 
 void System::listAllUsers() {
-    Auth auth(db);
+    Auth auth(storage);
     auth.listAllUsers(currentUser, currentRole);
 }
 
 void System::changeUserRole() {
-    Auth auth(db);
+    Auth auth(storage);
 
     std::string targetUser, roleStr;
     std::cout << "\n=== CHANGE USER ROLE ===\n";
@@ -561,34 +979,41 @@ void System::displayAllUserCalculations() {
     std::cout << "\n=== ALL USER CALCULATIONS (ADMIN VIEW) ===\n";
 
     // Get calculations for all users
-    std::vector<CalculationRecord> records = calcHistory.getRecentCalculations(100);
-
-    if (records.empty()) {
+    CalculationPage page = calcHistory.getCalculationPage("", 100);
+    if (page.records.empty()) {
         std::cout << "No calculations found.\n";
         return;
     }
 
-    std::cout << std::left << std::setw(5) << "ID"
-        << std::setw(15) << "Date"
-        << std::setw(12) << "User"
-        << std::setw(15) << "Mission"
-        << std::setw(12) << "Vehicle"
-        << std::setw(10) << "Distance"
-        << std::setw(12) << "Fuel (L)"
-        << "\n";
-    std::cout << std::string(81, '-') << "\n";
-
-    for (const auto& record : records) {
-        std::cout << std::left << std::setw(5) << record.id
-            << std::setw(15) << record.getFormattedDate()
-            << std::setw(12) << record.username
-            << std::setw(15) << (record.mission_name.length() > 14 ?
-                record.mission_name.substr(0, 14) + "." : record.mission_name)
-            << std::setw(12) << record.vehicle_id
-            << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
-            << std::setw(12) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
+    std::string token;
+    do {
+        if (!token.empty()) {
+            page = calcHistory.getCalculationPage("", 100, token);
+        }
+        const std::vector<CalculationRecord>& records = page.records;
+
+        std::cout << std::left << std::setw(5) << "ID"
+            << std::setw(15) << "Date"
+            << std::setw(12) << "User"
+            << std::setw(15) << "Mission"
+            << std::setw(12) << "Vehicle"
+            << std::setw(10) << "Distance"
+            << std::setw(12) << "Fuel (L)"
             << "\n";
-    }
+        std::cout << std::string(81, '-') << "\n";
+
+        for (const auto& record : records) {
+            std::cout << std::left << std::setw(5) << record.id
+                << std::setw(15) << record.getFormattedDate()
+                << std::setw(12) << record.username
+                << std::setw(15) << (record.mission_name.length() > 14 ?
+                    record.mission_name.substr(0, 14) + "." : record.mission_name)
+                << std::setw(12) << record.vehicle_id
+                << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
+                << std::setw(12) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
+                << "\n";
+        }
+    } while (choosePage(page, token));
 }
 
 void System::exportCalculationHistory() {
@@ -605,6 +1030,22 @@ void System::exportCalculationHistory() {
     }
 }
 
+void System::exportAllUsersHistory() {
+    std::cout << "\n=== EXPORT ALL USERS ===\n";
+    std::string prefix;
+    std::cout << "Enter file prefix: ";
+    std::cin >> prefix;
+
+    auto start = std::chrono::steady_clock::now();
+    int files = calcHistory.exportAllUsersToCSV(prefix, workers);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Exported " << files << " user file(s) in "
+        << std::fixed << std::setprecision(2) << seconds << " s using "
+        << (std::min)(workers.size(), storage->maxConcurrency()) << " concurrent scan(s).\n";
+    storage->displayStats();
+}
+
 // FUEL PRICE MANAGEMENT FUNCTIONS
 void System::manageFuelPrice() {
     int choice;
@@ -635,7 +1076,7 @@ void System::manageFuelPrice() {
 void System::updateFuelPrice() {
     std::cout << "\n=== UPDATE FUEL PRICE ===\n";
 
-    Cost costCalculator(db); // Pass the DatabaseManager to Cost constructor
+    Cost costCalculator(storage); // Fuel price is read from and saved to storage
     costCalculator.displayCurrentPrice();
 
     double newPrice;
@@ -671,12 +1112,17 @@ void System::updateFuelPrice() {
 void System::displayFuelPrice() {
     std::cout << "\n=== CURRENT FUEL PRICE ===\n";
 
-    Cost costCalculator(db); // Pass the DatabaseManager to Cost constructor
+    Cost costCalculator(storage); // Fuel price is read from and saved to storage
     costCalculator.displayCurrentPrice();
 }
 
 // CALCULATION HISTORY FUNCTIONS
 void System::viewCalculationHistory() {
+    // Reads below should see every mission run so far
+    if (!historyWriter.flush()) {
+        std::cerr << "Warning: some calculations are still waiting to be saved.\n";
+    }
+
     std::cout << "\n=== CALCULATION HISTORY ===\n";
     std::cout << "1. View My Calculations\n";
     std::cout << "2. View Recent Calculations (All Users)\n";
@@ -685,6 +1131,7 @@ void System::viewCalculationHistory() {
     if (currentRole == Auth::Role::ADMIN) {
         std::cout << "5. Delete My Calculation History\n";
         std::cout << "6. View All User Calculations (Admin)\n";
+        std::cout << "7. Export All Users to CSV (Parallel)\n";
     }
     std::cout << "0. Back to Main Menu\n";
     std::cout << "Selection: ";
@@ -715,6 +1162,11 @@ void System::viewCalculationHistory() {
             displayAllUserCalculations();
         }
         break;
+    case 7:
+        if (currentRole == Auth::Role::ADMIN) {
+            exportAllUsersHistory();
+        }
+        break;
     default:
         break;
     }
@@ -751,7 +1203,7 @@ void System::saveCalculationToHistory(const std::string& mission_name, double di
     record.fuel_consumed_liters = fuel_consumed;
 
     // Calculate cost per km
-    Cost costCalculator(db); // Pass the DatabaseManager to Cost constructor
+    Cost costCalculator(storage); // Fuel price is read from and saved to storage
     if (distance > 0) {
         double km_per_l = distance / fuel_consumed;
         record.cost_per_km = costCalculator.calculate(km_per_l);
@@ -760,98 +1212,132 @@ void System::saveCalculationToHistory(const std::string& mission_name, double di
         record.cost_per_km = 0.0;
     }
 
-    // Save to database
-    if (calcHistory.saveCalculation(record)) {
-        // Successfully saved
-    }
-    else {
+    // Queued; written to the database in the background
+    if (!historyWriter.submit(std::move(record))) {
         std::cerr << "Warning: Could not save calculation to history.\n";
     }
 }
 
 void System::displayUserCalculations() {
-    std::vector<CalculationRecord> records = calcHistory.getUserCalculations(currentUser, 50);
-
-    if (records.empty()) {
+    CalculationPage page = calcHistory.getCalculationPage(currentUser, 50);
+    if (page.records.empty()) {
         std::cout << "\nNo calculation history found for user: " << currentUser << "\n";
         return;
     }
 
-    std::cout << "\n=== My Calculation History ===\n";
-    std::cout << "Total calculations: " << records.size() << "\n\n";
-
-    std::cout << std::left << std::setw(5) << "ID"
-        << std::setw(15) << "Date"
-        << std::setw(15) << "Mission"
-        << std::setw(12) << "Vehicle"
-        << std::setw(10) << "Distance"
-        << std::setw(10) << "Speed"
-        << std::setw(12) << "Fuel (L)"
-        << std::setw(12) << "Cost/km"
-        << "\n";
-    std::cout << std::string(91, '-') << "\n";
-
-    for (const auto& record : records) {
-        std::cout << std::left << std::setw(5) << record.id
-            << std::setw(15) << record.getFormattedDate()
-            << std::setw(15) << (record.mission_name.length() > 14 ?
-                record.mission_name.substr(0, 14) + "." : record.mission_name)
-            << std::setw(12) << (record.vehicle_id.length() > 11 ?
-                record.vehicle_id.substr(0, 11) + "." : record.vehicle_id)
-            << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
-            << std::setw(10) << std::fixed << std::setprecision(1) << record.avg_speed_kmh
-            << std::setw(12) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
-            << std::setw(12) << std::fixed << std::setprecision(3) << record.cost_per_km
+    std::string token;
+    do {
+        if (!token.empty()) {
+            page = calcHistory.getCalculationPage(currentUser, 50, token);
+        }
+        const std::vector<CalculationRecord>& records = page.records;
+
+        std::cout << "\n=== My Calculation History ===\n";
+        std::cout << "Showing " << records.size() << " calculations\n\n";
+
+        std::cout << std::left << std::setw(5) << "ID"
+            << std::setw(15) << "Date"
+            << std::setw(15) << "Mission"
+            << std::setw(12) << "Vehicle"
+            << std::setw(10) << "Distance"
+            << std::setw(10) << "Speed"
+            << std::setw(12) << "Fuel (L)"
+            << std::setw(12) << "Cost/km"
             << "\n";
-    }
+        std::cout << std::string(91, '-') << "\n";
 
-    // Show summary
-    double total_fuel = 0;
-    double total_distance = 0;
-    for (const auto& record : records) {
-        total_fuel += record.fuel_consumed_liters;
-        total_distance += record.distance_km;
-    }
+        for (const auto& record : records) {
+            std::cout << std::left << std::setw(5) << record.id
+                << std::setw(15) << record.getFormattedDate()
+                << std::setw(15) << (record.mission_name.length() > 14 ?
+                    record.mission_name.substr(0, 14) + "." : record.mission_name)
+                << std::setw(12) << (record.vehicle_id.length() > 11 ?
+                    record.vehicle_id.substr(0, 11) + "." : record.vehicle_id)
+                << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
+                << std::setw(10) << std::fixed << std::setprecision(1) << record.avg_speed_kmh
+                << std::setw(12) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
+                << std::setw(12) << std::fixed << std::setprecision(3) << record.cost_per_km
+                << "\n";
+        }
 
-    std::cout << "\n--- Summary ---\n";
-    std::cout << "Total Fuel Consumed: " << std::fixed << std::setprecision(2) << total_fuel << " L\n";
-    std::cout << "Total Distance: " << std::fixed << std::setprecision(1) << total_distance << " km\n";
-    if (total_distance > 0) {
-        std::cout << "Average Fuel Efficiency: " << std::fixed << std::setprecision(2)
-            << (total_distance / total_fuel) << " km/L\n";
-        std::cout << "Total Fuel Cost: RM " << std::fixed << std::setprecision(2)
-            << (total_fuel * 2.0) << "\n";
-    }
+        // Show summary
+        double total_fuel = 0;
+        double total_distance = 0;
+        for (const auto& record : records) {
+            total_fuel += record.fuel_consumed_liters;
+            total_distance += record.distance_km;
+        }
+
+        std::cout << "\n--- Page Summary ---\n";
+        std::cout << "Total Fuel Consumed: " << std::fixed << std::setprecision(2) << total_fuel << " L\n";
+        std::cout << "Total Distance: " << std::fixed << std::setprecision(1) << total_distance << " km\n";
+        if (total_distance > 0) {
+            std::cout << "Average Fuel Efficiency: " << std::fixed << std::setprecision(2)
+                << (total_distance / total_fuel) << " km/L\n";
+            std::cout << "Total Fuel Cost: RM " << std::fixed << std::setprecision(2)
+                << (total_fuel * 2.0) << "\n";
+        }
+    } while (choosePage(page, token));
 }
 
 void System::displayRecentCalculations() {
-    std::vector<CalculationRecord> records = calcHistory.getRecentCalculations(20);
-
-    if (records.empty()) {
+    CalculationPage page = calcHistory.getCalculationPage("", 20);
+    if (page.records.empty()) {
         std::cout << "\nNo recent calculations found.\n";
         return;
     }
 
-    std::cout << "\n=== Recent Calculations (All Users) ===\n";
-    std::cout << std::left << std::setw(5) << "ID"
-        << std::setw(15) << "Date"
-        << std::setw(10) << "User"
-        << std::setw(12) << "Vehicle"
-        << std::setw(10) << "Distance"
-        << std::setw(10) << "Fuel (L)"
-        << "\n";
-    std::cout << std::string(62, '-') << "\n";
-
-    for (const auto& record : records) {
-        std::cout << std::left << std::setw(5) << record.id
-            << std::setw(15) << record.getFormattedDate()
-            << std::setw(10) << record.username
-            << std::setw(12) << (record.vehicle_id.length() > 11 ?
-                record.vehicle_id.substr(0, 11) + "." : record.vehicle_id)
-            << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
-            << std::setw(10) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
+    std::string token;
+    do {
+        if (!token.empty()) {
+            page = calcHistory.getCalculationPage("", 20, token);
+        }
+        const std::vector<CalculationRecord>& records = page.records;
+
+        std::cout << "\n=== Recent Calculations (All Users) ===\n";
+        std::cout << std::left << std::setw(5) << "ID"
+            << std::setw(15) << "Date"
+            << std::setw(10) << "User"
+            << std::setw(12) << "Vehicle"
+            << std::setw(10) << "Distance"
+            << std::setw(10) << "Fuel (L)"
             << "\n";
+        std::cout << std::string(62, '-') << "\n";
+
+        for (const auto& record : records) {
+            std::cout << std::left << std::setw(5) << record.id
+                << std::setw(15) << record.getFormattedDate()
+                << std::setw(10) << record.username
+                << std::setw(12) << (record.vehicle_id.length() > 11 ?
+                    record.vehicle_id.substr(0, 11) + "." : record.vehicle_id)
+                << std::setw(10) << std::fixed << std::setprecision(1) << record.distance_km
+                << std::setw(10) << std::fixed << std::setprecision(2) << record.fuel_consumed_liters
+                << "\n";
+        }
+    } while (choosePage(page, token));
+}
+
+bool System::choosePage(const CalculationPage& page, std::string& token) {
+    if (page.nextToken.empty() && page.prevToken.empty()) {
+        return false;
+    }
+
+    std::cout << "\n";
+    if (!page.prevToken.empty()) std::cout << "P. Previous Page  ";
+    if (!page.nextToken.empty()) std::cout << "N. Next Page  ";
+    std::cout << "0. Back\nSelection: ";
+
+    char choice;
+    std::cin >> choice;
+    if ((choice == 'n' || choice == 'N') && !page.nextToken.empty()) {
+        token = page.nextToken;
+        return true;
+    }
+    if ((choice == 'p' || choice == 'P') && !page.prevToken.empty()) {
+        token = page.prevToken;
+        return true;
     }
+    return false;
 }
 
 void System::displayCalculationStatistics() {
@@ -0,0 +1,132 @@
+#include "Thread_Pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFn& body) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    std::lock_guard<std::mutex> submit(submitLock);
+
+    size_t chunks = (count + grain - 1) / grain;
+    size_t perWorker = (chunks + workers.size() - 1) / workers.size();
+
+    // Publish the job before any task is visible: a worker still draining the
+    // previous job may pick up a new task as soon as it is pushed.
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        currentBody = &body;
+        firstError = nullptr;
+        remaining.store(chunks);
+    }
+
+    // Contiguous blocks of chunks per worker keep neighbouring grid cells together
+    for (size_t w = 0; w < workers.size(); ++w) {
+        std::lock_guard<std::mutex> guard(queues[w]->lock);
+        size_t firstChunk = w * perWorker;
+        size_t lastChunk = (std::min)(chunks, firstChunk + perWorker);
+        for (size_t c = firstChunk; c < lastChunk; ++c) {
+            size_t begin = c * grain;
+            queues[w]->tasks.push_back({ begin, (std::min)(count, begin + grain) });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        ++generation;
+    }
+    workAvailable.notify_all();
+
+    std::unique_lock<std::mutex> wait(stateLock);
+    workDone.wait(wait, [this] { return remaining.load() == 0; });
+    currentBody = nullptr;
+
+    if (firstError) {
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    size_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> wait(stateLock);
+            workAvailable.wait(wait, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        Task task;
+        while (popTask(index, task)) {
+            runTask(task, index);
+        }
+    }
+}
+
+bool ThreadPool::popTask(size_t index, Task& out) {
+    // Own queue first (LIFO keeps the working set warm)
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            out = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal from the front of the other queues
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            out = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::runTask(const Task& task, size_t index) {
+    try {
+        (*currentBody)(task.begin, task.end, index);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> guard(stateLock);
+        if (!firstError) firstError = std::current_exception();
+    }
+
+    if (remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> guard(stateLock);
+        workDone.notify_all();
+    }
+}
@@ -0,0 +1,238 @@
+#include "Vehicle_Catalog.h"
+#include "Storage.h"
+#include <algorithm>
+
+namespace {
+
+    bool idLess(const Vehicle& a, const Vehicle& b) {
+        return a.vehicle_id < b.vehicle_id;
+    }
+
+    // The record's columns and the coefficients derived from them; `out`
+    // keeps its own storage, cache and catalog
+    void copyAttributes(const Vehicle& from, Vehicle& out) {
+        out.vehicle_id = from.vehicle_id;
+        out.model_name = from.model_name;
+        out.massKg = from.massKg;
+        out.dragCoef = from.dragCoef;
+        out.frontalArea = from.frontalArea;
+        out.tirePressureBar = from.tirePressureBar;
+        out.engineRatedPower = from.engineRatedPower;
+        out.efficiency = from.efficiency;
+        out.hasAC = from.hasAC;
+        out.coefficients = from.coefficients;
+    }
+
+}
+
+VehicleCatalog::Pin::Pin(const VehicleCatalog& catalog) : catalog(catalog) {
+    // Counted before the pointer is read: a writer that sees no readers after
+    // its swap knows every reader of an old snapshot has pinned it already
+    catalog.readers.fetch_add(1);
+    snapshot = catalog.current.load();
+    snapshot->pins.fetch_add(1);
+    catalog.readers.fetch_sub(1);
+}
+
+VehicleCatalog::Pin::~Pin() {
+    snapshot->pins.fetch_sub(1);
+}
+
+// FNV-1a
+uint64_t VehicleCatalog::hashId(const std::string& id) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : id) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+int32_t VehicleCatalog::Snapshot::indexOf(const std::string& id, uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        int32_t index = slots[i];
+        if (index < 0) return -1;
+        if (hashes[index] == hash && records[index].vehicle_id == id) return index;
+    }
+}
+
+std::unique_ptr<VehicleCatalog::Snapshot> VehicleCatalog::build(std::vector<Vehicle> records, uint64_t version) {
+    std::unique_ptr<Snapshot> next(new Snapshot());
+    next->records = std::move(records);
+    next->version = version;
+    for (Vehicle& record : next->records) record.refreshCoefficients();
+
+    // At most half full, so probe runs stay short and a miss always ends
+    size_t capacity = 16;
+    while (capacity < next->records.size() * 2) capacity <<= 1;
+    next->slots.assign(capacity, -1);
+    next->hashes.reserve(next->records.size());
+
+    size_t mask = capacity - 1;
+    for (size_t r = 0; r < next->records.size(); ++r) {
+        uint64_t h = hashId(next->records[r].vehicle_id);
+        next->hashes.push_back(h);
+
+        size_t i = (size_t)h & mask;
+        while (next->slots[i] >= 0) i = (i + 1) & mask;
+        next->slots[i] = (int32_t)r;
+    }
+    return next;
+}
+
+VehicleCatalog::VehicleCatalog(Storage* storage) : storage(storage), current(nullptr), readers(0) {
+    std::lock_guard<std::mutex> guard(writeLock);
+    publish(std::vector<Vehicle>());
+}
+
+void VehicleCatalog::publish(std::vector<Vehicle> records) {
+    uint64_t version = live ? live->version + 1 : 0;
+    std::unique_ptr<const Snapshot> next = build(std::move(records), version);
+
+    current.store(next.get());
+    if (live) retired.push_back(std::move(live));
+    live = std::move(next);
+    reclaim();
+}
+
+void VehicleCatalog::reclaim() {
+    // A reader between reading `current` and pinning may hold any of them
+    if (readers.load() != 0) return;
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [](const std::unique_ptr<const Snapshot>& old) { return old->pins.load() == 0; }), retired.end());
+}
+
+bool VehicleCatalog::load() {
+    if (!storage) return false;
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    std::vector<Vehicle> records;
+    if (!storage->loadAllVehicles(records)) return false;   // keeps what is published
+    std::sort(records.begin(), records.end(), idLess);
+    publish(std::move(records));
+    return true;
+}
+
+void VehicleCatalog::reset(std::vector<Vehicle> vehicles) {
+    std::lock_guard<std::mutex> guard(writeLock);
+    std::sort(vehicles.begin(), vehicles.end(), idLess);
+    publish(std::move(vehicles));
+}
+
+bool VehicleCatalog::find(const std::string& id, Vehicle& out) const {
+    Pin snapshot(*this);
+    int32_t index = snapshot->indexOf(id, hashId(id));
+    if (index < 0) return false;
+    copyAttributes(snapshot->records[index], out);
+    return true;
+}
+
+bool VehicleCatalog::contains(const std::string& id) const {
+    Pin snapshot(*this);
+    return snapshot->indexOf(id, hashId(id)) >= 0;
+}
+
+std::vector<Vehicle> VehicleCatalog::all() const {
+    Pin snapshot(*this);
+    return snapshot->records;
+}
+
+size_t VehicleCatalog::size() const {
+    Pin snapshot(*this);
+    return snapshot->records.size();
+}
+
+uint64_t VehicleCatalog::version() const {
+    Pin snapshot(*this);
+    return snapshot->version;
+}
+
+int VehicleCatalog::add(const Vehicle& vehicle) {
+    if (!storage) return -1;
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    int inserted = storage->insertVehicle(vehicle);
+    if (inserted <= 0) return inserted;
+
+    std::vector<Vehicle> records = live->records;
+    auto at = std::lower_bound(records.begin(), records.end(), vehicle, idLess);
+    if (at != records.end() && at->vehicle_id == vehicle.vehicle_id) {
+        *at = vehicle;
+    }
+    else {
+        records.insert(at, vehicle);
+    }
+    publish(std::move(records));
+    return inserted;
+}
+
+int VehicleCatalog::update(const Vehicle& changes) {
+    if (!storage) return -1;
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    int matched = storage->updateVehicle(changes);
+    if (matched <= 0) return matched;
+
+    std::vector<Vehicle> records = live->records;
+    auto at = std::lower_bound(records.begin(), records.end(), changes, idLess);
+    if (at != records.end() && at->vehicle_id == changes.vehicle_id) {
+        at->applyChanges(changes);
+    }
+    else {
+        // Added behind our back since load(); take the merged row from storage
+        Vehicle stored(storage);
+        if (!storage->loadVehicle(changes.vehicle_id, stored)) return matched;
+        records.insert(at, stored);
+    }
+    publish(std::move(records));
+    return matched;
+}
+
+int VehicleCatalog::remove(const std::string& id) {
+    if (!storage) return -1;
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    int deleted = storage->deleteVehicle(id);
+    if (deleted < 0) return deleted;
+
+    // Also drops a row that another process deleted since load()
+    int32_t index = live->indexOf(id, hashId(id));
+    if (index >= 0) {
+        std::vector<Vehicle> records = live->records;
+        records.erase(records.begin() + index);
+        publish(std::move(records));
+    }
+    return deleted;
+}
+
+int VehicleCatalog::upsert(const std::vector<Vehicle>& vehicles) {
+    if (!storage) return -1;
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    int written = storage->upsertVehicles(vehicles);
+    if (written <= 0) return written;
+
+    // Sorted batch merged into the current records; for a repeated id the
+    // last occurrence in the batch is the row storage kept
+    std::vector<Vehicle> batch = vehicles;
+    std::stable_sort(batch.begin(), batch.end(), idLess);
+
+    const std::vector<Vehicle>& old = live->records;
+    std::vector<Vehicle> records;
+    records.reserve(old.size() + batch.size());
+
+    size_t i = 0;
+    size_t j = 0;
+    while (j < batch.size()) {
+        while (j + 1 < batch.size() && batch[j + 1].vehicle_id == batch[j].vehicle_id) ++j;
+
+        while (i < old.size() && old[i].vehicle_id < batch[j].vehicle_id) records.push_back(old[i++]);
+        if (i < old.size() && old[i].vehicle_id == batch[j].vehicle_id) ++i;
+        records.push_back(batch[j++]);
+    }
+    records.insert(records.end(), old.begin() + i, old.end());
+
+    publish(std::move(records));
+    return written;
+}
@@ -0,0 +1,57 @@
+#include "Vehicle.h"
+#include <cmath>
+
+// Storage-independent parts of Vehicle, kept apart from vehicle.cpp so the
+// calculation code links without a storage backend.
+
+Vehicle::Vehicle(Storage* storage)
+    : storage(storage), vehicle_id(""), model_name(""), massKg(0), dragCoef(0),
+    frontalArea(0), tirePressureBar(2.4), engineRatedPower(0),
+    efficiency(0), hasAC(false) {
+    refreshCoefficients();
+}
+
+Vehicle::Vehicle(std::string id, double mass, double cd, double area, double power)
+    : vehicle_id(id), massKg(mass), dragCoef(cd), frontalArea(area),
+    engineRatedPower(power), tirePressureBar(2.4), efficiency(0),
+    hasAC(false), storage(nullptr) {
+    refreshCoefficients();
+}
+
+Vehicle::~Vehicle() {
+}
+
+void Vehicle::applyChanges(const Vehicle& changes) {
+    if (!changes.model_name.empty()) model_name = changes.model_name;
+    if (changes.efficiency > 0) efficiency = changes.efficiency;
+    if (changes.massKg > 0) massKg = changes.massKg;
+    if (changes.dragCoef > 0) dragCoef = changes.dragCoef;
+    if (changes.frontalArea > 0) frontalArea = changes.frontalArea;
+    if (changes.engineRatedPower > 0) engineRatedPower = changes.engineRatedPower;
+    if (changes.tirePressureBar > 0) tirePressureBar = changes.tirePressureBar;
+    hasAC = changes.hasAC;
+    refreshCoefficients();
+}
+
+VehicleCoefficients::VehicleCoefficients(double massKg, double dragCoef, double frontalArea,
+    double tirePressureBar, double engineRatedPower)
+    : weightN(massKg * 9.81),
+    rollFactor(massKg * 9.81 * std::pow(tirePressureBar, -0.477)),
+    aeroFactor(0.5 * dragCoef * frontalArea),
+    ratedPowerW(engineRatedPower * 1000.0),
+    massKg(massKg), dragCoef(dragCoef), frontalArea(frontalArea),
+    tirePressureBar(tirePressureBar), engineRatedPower(engineRatedPower) {
+}
+
+void Vehicle::refreshCoefficients() {
+    coefficients = VehicleCoefficients(massKg, dragCoef, frontalArea, tirePressureBar, engineRatedPower);
+}
+
+VehicleCoefficients Vehicle::currentCoefficients() const {
+    const VehicleCoefficients& c = coefficients;
+    if (c.massKg == massKg && c.dragCoef == dragCoef && c.frontalArea == frontalArea
+        && c.tirePressureBar == tirePressureBar && c.engineRatedPower == engineRatedPower) {
+        return c;
+    }
+    return VehicleCoefficients(massKg, dragCoef, frontalArea, tirePressureBar, engineRatedPower);
+}
@@ -0,0 +1,287 @@
+#include "Vehicle_Importer.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+    enum Column { ID, MODEL, EFFICIENCY, MASS, DRAG, AREA, POWER, TIRE, AC, COLUMNS };
+
+    const char* COLUMN_NAMES[COLUMNS] = {
+        "vehicle_id", "model_name", "base_efficiency", "mass_kg", "drag_coef",
+        "frontal_area", "engine_rated_power", "tire_pressure_bar", "has_ac"
+    };
+
+    // Single-row retries that may all fail before the backend is given up on
+    const size_t MAX_BLIND_RETRIES = 10;
+
+    // Widths of the vehicles columns
+    const size_t MAX_ID_LENGTH = 50;
+    const size_t MAX_MODEL_LENGTH = 100;
+
+    std::string trim(const std::string& text) {
+        size_t begin = 0;
+        size_t end = text.size();
+        while (begin < end && std::isspace((unsigned char)text[begin])) ++begin;
+        while (end > begin && std::isspace((unsigned char)text[end - 1])) --end;
+        return text.substr(begin, end - begin);
+    }
+
+    std::string lower(std::string text) {
+        for (char& c : text) c = (char)std::tolower((unsigned char)c);
+        return text;
+    }
+
+    // Splits one line into `fields` (reused between calls); false on an
+    // unterminated quote
+    bool splitLine(const std::string& line, std::vector<std::string>& fields) {
+        fields.clear();
+        std::string field;
+        bool quoted = false;
+
+        for (size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (quoted) {
+                if (c != '"') {
+                    field += c;
+                }
+                else if (i + 1 < line.size() && line[i + 1] == '"') {
+                    field += '"';
+                    ++i;
+                }
+                else {
+                    quoted = false;
+                }
+            }
+            else if (c == '"') {
+                quoted = true;
+            }
+            else if (c == ',') {
+                fields.push_back(trim(field));
+                field.clear();
+            }
+            else {
+                field += c;
+            }
+        }
+        fields.push_back(trim(field));
+        return !quoted;
+    }
+
+    bool parsePositive(const std::string& text, double& value) {
+        if (text.empty()) return false;
+        const char* end = text.c_str() + text.size();
+        std::from_chars_result r = std::from_chars(text.c_str(), end, value);
+        return r.ec == std::errc() && r.ptr == end && std::isfinite(value) && value > 0;
+    }
+
+    bool parseFlag(const std::string& text, bool& value) {
+        std::string t = lower(text);
+        if (t.empty() || t == "n" || t == "no" || t == "0" || t == "false") {
+            value = false;
+            return true;
+        }
+        if (t == "y" || t == "yes" || t == "1" || t == "true") {
+            value = true;
+            return true;
+        }
+        return false;
+    }
+
+    // Fills `out` from one data row; the reason goes to `error` otherwise
+    bool parseRow(const std::vector<std::string>& fields, const int* position, Vehicle& out, std::string& error) {
+        auto field = [&](Column column) -> const std::string& {
+            static const std::string missing;
+            int at = position[column];
+            return at >= 0 && (size_t)at < fields.size() ? fields[at] : missing;
+        };
+
+        out.vehicle_id = field(ID);
+        out.model_name = field(MODEL);
+        if (out.vehicle_id.empty() || out.vehicle_id.size() > MAX_ID_LENGTH) {
+            error = "vehicle_id must be 1-50 characters";
+            return false;
+        }
+        if (out.model_name.empty() || out.model_name.size() > MAX_MODEL_LENGTH) {
+            error = "model_name must be 1-100 characters";
+            return false;
+        }
+
+        const Column numeric[] = { EFFICIENCY, MASS, DRAG, AREA, POWER };
+        double* targets[] = { &out.efficiency, &out.massKg, &out.dragCoef, &out.frontalArea, &out.engineRatedPower };
+        for (int k = 0; k < 5; ++k) {
+            if (!parsePositive(field(numeric[k]), *targets[k])) {
+                error = std::string(COLUMN_NAMES[numeric[k]]) + " must be a positive number, got '" + field(numeric[k]) + "'";
+                return false;
+            }
+        }
+
+        out.tirePressureBar = 2.4;
+        if (!field(TIRE).empty() && !parsePositive(field(TIRE), out.tirePressureBar)) {
+            error = "tire_pressure_bar must be a positive number, got '" + field(TIRE) + "'";
+            return false;
+        }
+        if (!parseFlag(field(AC), out.hasAC)) {
+            error = "has_ac must be y/n, got '" + field(AC) + "'";
+            return false;
+        }
+        return true;
+    }
+
+}
+
+VehicleImporter::VehicleImporter(Storage* storage, VehicleCatalog* catalog, size_t batchSize)
+    : storage(storage), catalog(catalog), batchSize(batchSize > 0 ? batchSize : 1) {}
+
+int VehicleImporter::write(const std::vector<Vehicle>& vehicles) {
+    return catalog ? catalog->upsert(vehicles) : storage->upsertVehicles(vehicles);
+}
+
+bool VehicleImporter::flush(std::vector<Vehicle>& batch, std::vector<size_t>& lines, Result& result) {
+    if (batch.empty()) return true;
+    ++result.batches;
+
+    bool usable = true;
+    if (write(batch) >= 0) {
+        result.imported += batch.size();
+    }
+    else {
+        // Find the rows the backend refuses; the rest still go in
+        ++result.retriedBatches;
+        std::vector<Vehicle> single(1, Vehicle(storage));
+        size_t written = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (written == 0 && i >= MAX_BLIND_RETRIES) {
+                usable = false;
+            }
+            single[0] = batch[i];
+            if (usable && write(single) >= 0) {
+                ++written;
+                ++result.imported;
+            }
+            else {
+                ++result.rejected;
+                result.errors.push_back({ lines[i], usable ? "rejected by storage" : "not written, storage unavailable" });
+            }
+        }
+    }
+    batch.clear();
+    lines.clear();
+    return usable;
+}
+
+bool VehicleImporter::importFile(const std::string& path, Result& result) {
+    result = Result();
+    if (!storage) {
+        std::cerr << "Storage not available.\n";
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << "\n";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::string line;
+    std::vector<std::string> fields;
+    if (!std::getline(file, line)) {
+        std::cerr << path << " is empty.\n";
+        return false;
+    }
+    if (line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3);   // UTF-8 BOM
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    // Header: which field holds which column
+    int position[COLUMNS];
+    std::fill(position, position + COLUMNS, -1);
+    splitLine(line, fields);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        std::string name = lower(fields[i]);
+        for (int c = 0; c < COLUMNS; ++c) {
+            if (name == COLUMN_NAMES[c]) position[c] = (int)i;
+        }
+    }
+    for (int c = ID; c <= POWER; ++c) {
+        if (position[c] < 0) {
+            std::cerr << path << ": header has no '" << COLUMN_NAMES[c] << "' column.\n";
+            return false;
+        }
+    }
+
+    std::vector<Vehicle> batch;
+    std::vector<size_t> lines;
+    batch.reserve(batchSize);
+    lines.reserve(batchSize);
+    std::unordered_map<std::string, size_t> firstLine;
+
+    Vehicle row(storage);
+    std::string error;
+    size_t lineNumber = 1;
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (trim(line).empty()) continue;
+        ++result.rows;
+
+        if (!splitLine(line, fields)) {
+            error = "unterminated quoted field";
+        }
+        else if (parseRow(fields, position, row, error)) {
+            auto seen = firstLine.emplace(row.vehicle_id, lineNumber);
+            if (seen.second) {
+                batch.push_back(row);
+                lines.push_back(lineNumber);
+                if (batch.size() >= batchSize && !flush(batch, lines, result)) {
+                    result.stopped = true;
+                    break;
+                }
+                continue;
+            }
+            error = "duplicate vehicle_id '" + row.vehicle_id + "', first on line " + std::to_string(seen.first->second);
+        }
+
+        ++result.rejected;
+        result.errors.push_back({ lineNumber, error });
+    }
+    if (!result.stopped && !flush(batch, lines, result)) {
+        result.stopped = true;
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void VehicleImporter::displayResult(const Result& result, size_t maxErrors) {
+    std::cout << "\n--- Import Summary ---\n";
+    std::cout << "Rows read: " << result.rows << "\n";
+    std::cout << "Imported:  " << result.imported << "\n";
+    std::cout << "Rejected:  " << result.rejected << "\n";
+    std::cout << "Batches:   " << result.batches;
+    if (result.retriedBatches > 0) {
+        std::cout << " (" << result.retriedBatches << " retried row by row)";
+    }
+    std::cout << "\n";
+    std::cout << "Time:      " << std::fixed << std::setprecision(2) << result.seconds << " s\n";
+    if (result.stopped) {
+        std::cout << "Import stopped early: the storage backend rejected every row it was given.\n";
+    }
+
+    if (result.errors.empty()) return;
+    std::cout << "\nErrors:\n";
+    for (size_t i = 0; i < result.errors.size() && i < maxErrors; ++i) {
+        std::cout << "  line " << result.errors[i].line << ": " << result.errors[i].message << "\n";
+    }
+    if (result.errors.size() > maxErrors) {
+        std::cout << "  (" << result.errors.size() - maxErrors << " more)\n";
+    }
+}